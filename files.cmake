@@ -1,3 +1,60 @@
+set(CORE_SOURCE_FILE
+        src/geometry/geometry_definition.hpp
+        src/geometry/geometry_utils.h
+        src/geometry/geometry_utils.cpp
+        src/geometry/zoom_utils.h
+        src/geometry/zoom_utils.cpp
+
+        src/provider/column.h
+        src/provider/dataset_diagnostics.h
+        src/provider/dataset_diagnostics.cpp
+        src/provider/feature_store.h
+        src/provider/feature_store.cpp
+        src/provider/feature_store_binary.h
+        src/provider/feature_store_binary.cpp
+        src/provider/label_table.h
+        src/provider/label_table.cpp
+        src/provider/palette.h
+        src/provider/palette.cpp
+        src/provider/render_data_definition.hpp
+        src/provider/render_data_field_decoder.h
+        src/provider/render_data_field_decoder.cpp
+        src/provider/render_data_provider.h
+        src/provider/render_data_provider.cpp
+        src/provider/render_data_geojson_provider.h
+        src/provider/render_data_geojson_provider.cpp
+        src/provider/render_data_geojson_stream.h
+        src/provider/render_data_geojson_stream.cpp
+        src/provider/render_data_sector_provider.h
+        src/provider/render_data_sector_provider.cpp
+        src/provider/render_data_sector_reader.h
+        src/provider/render_data_sector_reader.cpp
+        src/provider/render_data_yaml_provider.h
+        src/provider/render_data_yaml_provider.cpp
+        src/provider/render_data_yaml_chunks.h
+        src/provider/render_data_yaml_chunks.cpp
+        src/provider/render_data_yaml_stream.h
+        src/provider/render_data_yaml_stream.cpp
+        src/provider/tile_pyramid.h
+        src/provider/tile_pyramid.cpp
+
+        src/utils/epoch_snapshot.h
+        src/utils/file_watcher.h
+        src/utils/file_watcher.cpp
+        src/utils/hash_utils.h
+        src/utils/hash_utils.cpp
+        src/utils/json_sax_parser.h
+        src/utils/json_sax_parser.cpp
+        src/utils/logger.h
+        src/utils/logger.cpp
+        src/utils/mapped_file.h
+        src/utils/mapped_file.cpp
+        src/utils/string_utils.h
+        src/utils/string_utils.cpp
+        src/utils/worker_pool.h
+        src/utils/worker_pool.cpp
+)
+
 set(SOURCE_FILE
         main.cpp
 
@@ -6,12 +63,6 @@ set(SOURCE_FILE
         src/plugin/euroscope_render_plugin.h
         src/plugin/euroscope_render_plugin.cpp
 
-        src/provider/render_data_definition.hpp
-        src/provider/render_data_provider.h
-        src/provider/render_data_provider.cpp
-        src/provider/render_data_yaml_provider.h
-        src/provider/render_data_yaml_provider.cpp
-
         src/render/render.h
         src/render/direct2d_render.h
         src/render/direct2d_render.cpp
@@ -19,9 +70,19 @@ set(SOURCE_FILE
         src/render/gdi_plus_render.cpp
         src/render/radar_render.h
         src/render/radar_render.cpp
+)
 
-        src/utils/logger.h
-        src/utils/logger.cpp
-        src/utils/string_utils.h
-        src/utils/string_utils.cpp
+set(TEST_SOURCE_FILE
+        tests/feature_store_binary_test.cpp
+        tests/feature_store_test.cpp
+        tests/file_watcher_test.cpp
+        tests/geometry_utils_test.cpp
+        tests/json_sax_parser_test.cpp
+        tests/mapped_file_test.cpp
+        tests/render_data_geojson_stream_test.cpp
+        tests/render_data_sector_reader_test.cpp
+        tests/render_data_yaml_chunks_test.cpp
+        tests/render_data_yaml_provider_test.cpp
+        tests/tile_pyramid_test.cpp
+        tests/zoom_utils_test.cpp
 )
@@ -0,0 +1,49 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_GEOMETRY_DEFINITION_H
+#define RENDERPLUGIN_GEOMETRY_DEFINITION_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace RenderPlugin {
+    /** 屏幕像素坐标点，与平台无关（对应 Windows 的 POINT） */
+    struct PixelPoint {
+        int32_t x{};
+        int32_t y{};
+    };
+
+    /** 屏幕像素矩形，与平台无关（对应 Windows 的 RECT），边界均为闭区间 */
+    struct PixelRect {
+        int32_t left{};
+        int32_t top{};
+        int32_t right{};
+        int32_t bottom{};
+    };
+
+    /** 经纬度矩形（度），边界均为闭区间；默认构造为空矩形，可通过 expand 逐点扩展 */
+    struct GeoRect {
+        double mMinLongitude{std::numeric_limits<double>::infinity()};
+        double mMinLatitude{std::numeric_limits<double>::infinity()};
+        double mMaxLongitude{-std::numeric_limits<double>::infinity()};
+        double mMaxLatitude{-std::numeric_limits<double>::infinity()};
+
+        [[nodiscard]] bool empty() const {
+            return mMinLongitude > mMaxLongitude || mMinLatitude > mMaxLatitude;
+        }
+
+        void expand(double longitude, double latitude) {
+            mMinLongitude = longitude < mMinLongitude ? longitude : mMinLongitude;
+            mMaxLongitude = longitude > mMaxLongitude ? longitude : mMaxLongitude;
+            mMinLatitude = latitude < mMinLatitude ? latitude : mMinLatitude;
+            mMaxLatitude = latitude > mMaxLatitude ? latitude : mMaxLatitude;
+        }
+    };
+
+    /** 屏幕对应的经纬度范围：跨越 180° 经线时为经线两侧的两个矩形，否则第二个矩形为空 */
+    using GeoClipRects = std::array<GeoRect, 2>;
+}
+
+#endif
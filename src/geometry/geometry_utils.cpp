@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+
+#include "geometry_utils.h"
+
+namespace RenderPlugin {
+    bool pointInRect(const PixelPoint &p, const PixelRect &r) {
+        return p.x >= r.left && p.x <= r.right && p.y >= r.top && p.y <= r.bottom;
+    }
+
+    bool geoRectsIntersect(const GeoRect &a, const GeoRect &b) {
+        return a.mMinLongitude <= b.mMaxLongitude && a.mMaxLongitude >= b.mMinLongitude &&
+               a.mMinLatitude <= b.mMaxLatitude && a.mMaxLatitude >= b.mMinLatitude;
+    }
+
+    bool geoPointInRect(double longitude, double latitude, const GeoRect &r) {
+        return longitude >= r.mMinLongitude && longitude <= r.mMaxLongitude &&
+               latitude >= r.mMinLatitude && latitude <= r.mMaxLatitude;
+    }
+
+    double unwrapLongitude(double longitude, double reference) {
+        return reference + std::remainder(longitude - reference, 360.0);
+    }
+
+    GeoClipRects splitAtAntimeridian(const GeoRect &rect) {
+        if (rect.empty()) {
+            return {rect, GeoRect()};
+        }
+        GeoRect first = rect;
+        if (rect.mMaxLongitude - rect.mMinLongitude >= 360.0) {
+            first.mMinLongitude = -180.0;
+            first.mMaxLongitude = 180.0;
+            return {first, GeoRect()};
+        }
+        // move the west edge into [-180, 180), the east edge may then lie past 180
+        const double shift = std::floor((rect.mMinLongitude + 180.0) / 360.0) * 360.0;
+        first.mMinLongitude -= shift;
+        first.mMaxLongitude -= shift;
+        if (first.mMaxLongitude <= 180.0) {
+            return {first, GeoRect()};
+        }
+        GeoRect second = first;
+        second.mMinLongitude = -180.0;
+        second.mMaxLongitude = first.mMaxLongitude - 360.0;
+        first.mMaxLongitude = 180.0;
+        return {first, second};
+    }
+
+    bool segmentsIntersect(const PixelPoint &a, const PixelPoint &b, const PixelPoint &c, const PixelPoint &d) {
+        auto orient = [](const PixelPoint &p, const PixelPoint &q, const PixelPoint &r) {
+            return static_cast<int64_t>(q.x - p.x) * (r.y - p.y) - static_cast<int64_t>(q.y - p.y) * (r.x - p.x);
+        };
+        int64_t o1 = orient(a, b, c), o2 = orient(a, b, d), o3 = orient(c, d, a), o4 = orient(c, d, b);
+        if ((o1 > 0 && o2 > 0) || (o1 < 0 && o2 < 0) || (o3 > 0 && o4 > 0) || (o3 < 0 && o4 < 0)) {
+            return false;
+        }
+        if (o1 == 0 && o2 == 0) {
+            return (std::min)(a.x, b.x) <= (std::max)(c.x, d.x) && (std::max)(a.x, b.x) >= (std::min)(c.x, d.x) &&
+                   (std::min)(a.y, b.y) <= (std::max)(c.y, d.y) && (std::max)(a.y, b.y) >= (std::min)(c.y, d.y);
+        }
+        return true;
+    }
+
+    bool segmentIntersectsRect(const PixelPoint &a, const PixelPoint &b, const PixelRect &r) {
+        if (pointInRect(a, r) || pointInRect(b, r)) {
+            return true;
+        }
+        PixelPoint tl = {r.left, r.top};
+        PixelPoint tr = {r.right, r.top};
+        PixelPoint br = {r.right, r.bottom};
+        PixelPoint bl = {r.left, r.bottom};
+        return segmentsIntersect(a, b, tl, tr) || segmentsIntersect(a, b, tr, br) ||
+               segmentsIntersect(a, b, br, bl) || segmentsIntersect(a, b, bl, tl);
+    }
+
+    bool pointInPolygon(const PixelPoint &p, const std::vector<PixelPoint> &pts) {
+        if (pts.size() < 3) {
+            return false;
+        }
+        int n = static_cast<int>(pts.size());
+        int crossings = 0;
+        for (int i = 0, j = n - 1; i < n; j = i++) {
+            const auto &vi = pts[i];
+            const auto &vj = pts[j];
+            if ((vi.y > p.y) == (vj.y > p.y)) {
+                continue;
+            }
+            double tx = static_cast<double>(p.y - vj.y) * (vi.x - vj.x) / (vi.y - vj.y) + vj.x;
+            if (static_cast<double>(p.x) < tx) {
+                ++crossings;
+            }
+        }
+        return (crossings % 2) == 1;
+    }
+
+    bool isAnyPointInRect(const std::vector<PixelPoint> &points, const PixelRect &r) {
+        return std::any_of(points.begin(), points.end(), [&r](const PixelPoint &p) { return pointInRect(p, r); });
+    }
+
+    bool isPolygonIntersectingRect(const std::vector<PixelPoint> &points, const PixelRect &r) {
+        if (points.size() < 3) {
+            return false;
+        }
+        if (isAnyPointInRect(points, r)) {
+            return true;
+        }
+        for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+            if (segmentIntersectsRect(points[j], points[i], r)) {
+                return true;
+            }
+        }
+        PixelPoint center = {(r.left + r.right) / 2, (r.top + r.bottom) / 2};
+        return pointInPolygon(center, points);
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_GEOMETRY_UTILS_H
+#define RENDERPLUGIN_GEOMETRY_UTILS_H
+
+#include <vector>
+#include "geometry_definition.hpp"
+
+namespace RenderPlugin {
+    bool pointInRect(const PixelPoint &p, const PixelRect &r);
+
+    /** 两个经纬度矩形是否相交（含边界接触）；空矩形与任何矩形都不相交 */
+    bool geoRectsIntersect(const GeoRect &a, const GeoRect &b);
+
+    /** 经纬度点是否在矩形内（含边界） */
+    bool geoPointInRect(double longitude, double latitude, const GeoRect &r);
+
+    /** 将经度换算到 [reference - 180, reference + 180] 内，使跨越 180° 经线的一组经度连续 */
+    double unwrapLongitude(double longitude, double reference);
+
+    /**
+     * 将经度已展开（可超出 ±180）的矩形换算回 [-180, 180]：跨越 180° 经线时拆为两侧的两个矩形，
+     * 经度跨度达到 360° 时为整个经度范围
+     */
+    GeoClipRects splitAtAntimeridian(const GeoRect &rect);
+
+    bool segmentsIntersect(const PixelPoint &a, const PixelPoint &b, const PixelPoint &c, const PixelPoint &d);
+
+    bool segmentIntersectsRect(const PixelPoint &a, const PixelPoint &b, const PixelRect &r);
+
+    bool pointInPolygon(const PixelPoint &p, const std::vector<PixelPoint> &pts);
+
+    /** 是否至少有一个点落在矩形内，用于线段和文字 */
+    bool isAnyPointInRect(const std::vector<PixelPoint> &points, const PixelRect &r);
+
+    /** 多边形是否与矩形相交（顶点可在矩形外，区域经过矩形即返回 true），用于区域 */
+    bool isPolygonIntersectingRect(const std::vector<PixelPoint> &points, const PixelRect &r);
+}
+
+#endif
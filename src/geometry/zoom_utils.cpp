@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "zoom_utils.h"
+
+namespace RenderPlugin {
+    double getSpanDeg(double leftDownLongitude, double leftDownLatitude,
+                      double rightUpLongitude, double rightUpLatitude) {
+        const double spanLon = rightUpLongitude - leftDownLongitude;
+        const double spanLat = rightUpLatitude - leftDownLatitude;
+        return (std::max)(std::abs(spanLon), std::abs(spanLat));
+    }
+
+    int spanDegToZoomLevel(double spanDeg) {
+        if (spanDeg <= std::numeric_limits<double>::epsilon()) {
+            return MAX_ZOOM_LEVEL;
+        }
+
+        const double rawZoom = std::log2(360.0 / spanDeg);
+        int zoom = static_cast<int>(std::round(rawZoom));
+        return (std::clamp)(zoom, MIN_ZOOM_LEVEL, MAX_ZOOM_LEVEL);
+    }
+}
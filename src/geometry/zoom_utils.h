@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_ZOOM_UTILS_H
+#define RENDERPLUGIN_ZOOM_UTILS_H
+
+namespace RenderPlugin {
+    constexpr int MIN_ZOOM_LEVEL = 1;
+    constexpr int MAX_ZOOM_LEVEL = 19;
+
+    /** 视野的经纬度跨度（度），取经度、纬度跨度中的较大者；跨度为 0 时返回 0 */
+    double getSpanDeg(double leftDownLongitude, double leftDownLatitude,
+                      double rightUpLongitude, double rightUpLatitude);
+
+    /** 标准地图缩放 1–19：zoom ≈ log2(360 / spanDeg)；跨度为 0 时返回最大缩放等级 */
+    int spanDegToZoomLevel(double spanDeg);
+}
+
+#endif
@@ -4,9 +4,12 @@
 #ifndef RENDERPLUGIN_EUROSCOPE_RENDER_DEFINITION_H
 #define RENDERPLUGIN_EUROSCOPE_RENDER_DEFINITION_H
 
+#include <chrono>
 #include <filesystem>
 #include <string>
 #include "logger.h"
+#include "render_data_definition.hpp"
+#include "render_data_yaml_provider.h"
 
 namespace RenderPlugin {
     constexpr auto PLUGIN_NAME = "EuroScope Render Plugin";
@@ -24,6 +27,13 @@ namespace RenderPlugin {
     constexpr auto DEFAULT_RENDER_TYPE = "d2d";
     constexpr auto DEFAULT_LOG_LEVEL = "off";
     constexpr auto DEFAULT_TEXT_SIZE_REFERENCE_ZOOM = "12";
+    constexpr auto DEFAULT_COORDINATE_STORAGE = "double";
+    constexpr auto DEFAULT_LOAD_MODE = "parallel";
+    constexpr auto DEFAULT_BINARY_CACHE = "false";
+    constexpr auto DEFAULT_HOT_RELOAD = "false";
+    constexpr auto DEFAULT_DEFERRED_LOAD = "false";
+    // 数据文件最后一次变化后保持不变这么久才重新加载，合并编辑器的多次写入
+    constexpr auto HOT_RELOAD_QUIET_PERIOD = std::chrono::milliseconds(1500);
 
     constexpr auto SETTING_CONFIG_PATH = "ConfigPath";
     constexpr auto SETTING_LOG_PATH = "LogPath";
@@ -32,6 +42,16 @@ namespace RenderPlugin {
     constexpr auto SETTING_RENDER_TYPE = "RenderType";
     /** 文字大小参考缩放等级（1–19），配置中的 size 在该 zoom 下为参考像素；默认 12 */
     constexpr auto SETTING_TEXT_SIZE_REFERENCE_ZOOM = "TextSizeReferenceZoom";
+    /** 坐标存储方式：double（默认）或 quantized */
+    constexpr auto SETTING_COORDINATE_STORAGE = "CoordinateStorage";
+    /** 数据文件加载方式：parallel（默认）、stream 或 dom */
+    constexpr auto SETTING_LOAD_MODE = "LoadMode";
+    /** 是否在数据文件旁生成并使用 .erpbin 二进制缓存：false（默认）或 true；缓存写在数据文件所在目录，须有写权限 */
+    constexpr auto SETTING_BINARY_CACHE = "BinaryCache";
+    /** 数据文件变化时自动重新加载：false（默认）或 true */
+    constexpr auto SETTING_HOT_RELOAD = "HotReload";
+    /** 插件初始化时在后台线程加载数据文件，不阻塞 EuroScope 启动：false（默认）或 true */
+    constexpr auto SETTING_DEFERRED_LOAD = "DeferredLoad";
 
     namespace fs = std::filesystem;
 
@@ -65,6 +85,16 @@ namespace RenderPlugin {
         RenderType mRenderType;
         /** 文字 size 的参考缩放等级（1–19），该 zoom 下 size 即对应像素 */
         int mTextSizeReferenceZoom{12};
+        /** 坐标存储方式：double 或 int32 量化（顶点内存减半） */
+        CoordinateStorage mCoordinateStorage{CoordinateStorage::Double};
+        /** 数据文件加载方式 */
+        YamlLoadMode mLoadMode{YamlLoadMode::Parallel};
+        /** 是否使用二进制缓存 */
+        bool mBinaryCache{false};
+        /** 是否监视数据文件并自动重新加载 */
+        bool mHotReload{false};
+        /** 是否在后台加载初始数据集 */
+        bool mDeferredLoad{false};
 
         PluginConfig() {
             mDataFilePath = fs::current_path() / DEFAULT_CONFIG_PATH;
@@ -72,6 +102,11 @@ namespace RenderPlugin {
             mLogLevel = Logger::LogLevel::DBG;
             mRenderType = RenderType::D2D;
             mTextSizeReferenceZoom = 12;
+            mCoordinateStorage = CoordinateStorage::Double;
+            mLoadMode = YamlLoadMode::Parallel;
+            mBinaryCache = false;
+            mHotReload = false;
+            mDeferredLoad = false;
         }
     };
 }
@@ -2,12 +2,16 @@
 // SPDX-License-Identifier: MIT
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <utility>
 
 #include "euroscope_render_plugin.h"
 #include "EuroScopePlugIn.h"
 #include "direct2d_render.h"
 #include "gdi_plus_render.h"
+#include "render_data_geojson_provider.h"
+#include "render_data_sector_provider.h"
 #include "render_data_yaml_provider.h"
 
 namespace RenderPlugin {
@@ -28,9 +32,41 @@ namespace RenderPlugin {
         mLogger->debugf("Logger initialized, log level: {}", Logger::getLogLevelName(mConfig->mLogLevel));
         mLogger->debug("Plugin initializing...");
         mLogger->debugf("Data file path: {}", mConfig->mDataFilePath.string());
-        mDataProvider = std::make_shared<RenderDataYamlProvider>();
-        mDataProvider->loadData(mConfig->mDataFilePath);
-        mLogger->debug("Data provider initialized and data loaded");
+        mLogger->debugf("Coordinate storage: {}", coordinateStorageToString(mConfig->mCoordinateStorage));
+        mLogger->debugf("Load mode: {}", yamlLoadModeToString(mConfig->mLoadMode));
+        mLogger->debugf("Binary cache: {}", mConfig->mBinaryCache);
+        mLogger->debugf("Hot reload: {}", mConfig->mHotReload);
+        mLogger->debugf("Deferred load: {}", mConfig->mDeferredLoad);
+        mDataProvider = createDataProvider();
+        if (mConfig->mDeferredLoad) {
+            // EuroScope waits for the constructor, radar screens draw nothing until OnTimer publishes the data set
+            mInitialLoad = true;
+            launchLoad();
+            mLogger->debug("Data provider initialized, loading data in background");
+        } else {
+            // loaded on the side and adopted like a reload, so that the data set is published to the radar screens
+            try {
+                ProviderPtr loaded = createDataProvider();
+                if (loaded->loadData(mConfig->mDataFilePath)) {
+                    mDataProvider->adoptData(*loaded);
+                    logLoadErrors(*mDataProvider);
+                    const size_t errorCount = mDataProvider->getLoadErrors().size();
+                    if (errorCount > 0) {
+                        displayMessage(DisplayMessage::newErrorMessage(
+                                fmt::format("Data file loaded with {} error(s), see log for details", errorCount)));
+                    }
+                } else {
+                    mLogger->error("Failed to load data file: missing color or features section");
+                    displayMessage(DisplayMessage::newErrorMessage("Failed to load data file"));
+                }
+            } catch (const std::exception &e) {
+                // a YAML syntax error or an unreadable file must not take EuroScope down with the plugin
+                mLogger->errorf("Failed to load data file: {}", e.what());
+                displayMessage(DisplayMessage::newErrorMessage(fmt::format("Failed to load data file: {}", e.what())));
+            }
+            mLogger->debug("Data provider initialized");
+        }
+        watchSourceFiles();
         mLogger->debugf("Render type: {}", PluginConfig::getRenderTypeName(mConfig->mRenderType));
         if (mConfig->mRenderType == PluginConfig::RenderType::D2D) {
             mRender = std::make_shared<Direct2DRender>();
@@ -42,6 +78,10 @@ namespace RenderPlugin {
     }
 
     EuroScopeRenderPlugin::~EuroScopeRenderPlugin() {
+        // a load cannot be cancelled, wait for it so that the worker does not outlive the plugin
+        if (mPendingReload.valid()) {
+            mPendingReload.wait();
+        }
         mRadarScreensToRemove.clear();
         mRadarScreens.clear();
         if (mRender != nullptr) {
@@ -95,13 +135,7 @@ namespace RenderPlugin {
         std::string command(sCommandLine);
         mLogger->debugf("OnCompileCommand: command = {}", command);
         if (command == ".reload") {
-            mDataProvider->resetData();
-            bool success = mDataProvider->loadData(mConfig->mDataFilePath);
-            if (success) {
-                displayMessage(DisplayMessage::newMessage("Data file reloaded successfully"));
-            } else {
-                displayMessage(DisplayMessage::newErrorMessage("Failed to reload data file"));
-            }
+            startReload();
             return true;
         }
         if (command == ".zoom") {
@@ -118,6 +152,128 @@ namespace RenderPlugin {
         return false;
     }
 
+    void EuroScopeRenderPlugin::OnTimer(int Counter) {
+        pollReload();
+        mDataProvider->collectSnapshots();
+        // only the write time and size are checked here, the content hash is compared on the loader thread
+        if (mConfig->mHotReload && !mPendingReload.valid() && mFileWatcher.poll(FileWatcher::Clock::now())) {
+            mLogger->debug("Data file modified, reloading if its content changed");
+            startReload(mFileWatcher.files());
+        }
+    }
+
+    void EuroScopeRenderPlugin::watchSourceFiles() {
+        if (!mConfig->mHotReload) {
+            return;
+        }
+        auto files = mDataProvider->getSourceFiles();
+        if (files.empty()) {
+            // nothing loaded yet, watch the configured file so that fixing it triggers a load
+            files.push_back(WatchedFile::stat(mConfig->mDataFilePath));
+        }
+        mFileWatcher.watch(std::move(files));
+    }
+
+    void EuroScopeRenderPlugin::logLoadErrors(const RenderDataProvider &provider) const {
+        for (const auto &error: provider.getLoadErrors()) {
+            const std::string file = error.mFile.empty() ? mConfig->mDataFilePath.string() : error.mFile;
+            mLogger->warnf("{}:{}: {}", file, error.mLine, error.mMessage);
+        }
+        for (const auto &notice: provider.getLoadNotices()) {
+            mLogger->info(notice);
+        }
+    }
+
+    ProviderPtr EuroScopeRenderPlugin::createDataProvider() const {
+        ProviderPtr provider;
+        if (isGeoJsonPath(mConfig->mDataFilePath)) {
+            provider = std::make_shared<RenderDataGeoJsonProvider>();
+        } else if (isSectorFilePath(mConfig->mDataFilePath)) {
+            provider = std::make_shared<RenderDataSectorProvider>();
+        } else {
+            auto yamlProvider = std::make_shared<RenderDataYamlProvider>();
+            yamlProvider->setLoadMode(mConfig->mLoadMode);
+            provider = std::move(yamlProvider);
+        }
+        provider->setCoordinateStorage(mConfig->mCoordinateStorage);
+        provider->setBinaryCacheEnabled(mConfig->mBinaryCache);
+        return provider;
+    }
+
+    void EuroScopeRenderPlugin::startReload(std::vector<WatchedFile> baseline) {
+        if (mPendingReload.valid()) {
+            mReloadQueued = true;
+            displayMessage(DisplayMessage::newMessage("Reload already in progress, queued"));
+            return;
+        }
+        mReloadQueued = false;
+        mLogger->debugf("Reloading data file in background: {}", mConfig->mDataFilePath.string());
+        if (baseline.empty()) {
+            // a hot reload reports only once it knows the content changed
+            displayMessage(DisplayMessage::newMessage("Reloading data file..."));
+        }
+        launchLoad(std::move(baseline));
+    }
+
+    void EuroScopeRenderPlugin::launchLoad(std::vector<WatchedFile> baseline) {
+        // the new data set is loaded into its own provider, the current one keeps drawing until it is published
+        ProviderPtr provider = createDataProvider();
+        // unchanged features are copied from the data set on screen instead of decoded again
+        provider->setPreviousData(mDataProvider->getFeatureStore());
+        mPendingReload = std::async(std::launch::async, [provider = std::move(provider),
+                path = mConfig->mDataFilePath, baseline = std::move(baseline)]() -> LoadResult {
+            if (!baseline.empty() && !contentChanged(baseline)) {
+                return {nullptr, true};
+            }
+            return {provider->loadData(path) ? provider : nullptr};
+        });
+    }
+
+    void EuroScopeRenderPlugin::pollReload() {
+        if (!mPendingReload.valid() ||
+            mPendingReload.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        const bool initial = std::exchange(mInitialLoad, false);
+        const std::string_view action = initial ? "load" : "reload";
+        const std::string_view done = initial ? "loaded" : "reloaded";
+        try {
+            LoadResult result = mPendingReload.get();
+            ProviderPtr &loaded = result.mProvider;
+            if (result.mUnchanged) {
+                mLogger->debug("Data file content unchanged, reload skipped");
+            } else if (loaded != nullptr) {
+                // all radar screens share the provider and read it on this thread, so the swap is atomic for them
+                mDataProvider->adoptData(*loaded);
+                logLoadErrors(*mDataProvider);
+                watchSourceFiles();
+                removeClosedRadarScreens();
+                for (auto &screen: mRadarScreens) {
+                    screen->RefreshMapContent();
+                }
+                mLogger->debugf("Data file {}", done);
+                const size_t errorCount = mDataProvider->getLoadErrors().size();
+                if (errorCount > 0) {
+                    displayMessage(DisplayMessage::newErrorMessage(
+                            fmt::format("Data file {} with {} error(s), see log for details", done, errorCount)));
+                } else if (!initial) {
+                    // the initial load is silent unless something is wrong with the data file
+                    displayMessage(DisplayMessage::newMessage("Data file reloaded successfully"));
+                }
+            } else {
+                mLogger->errorf("Failed to {} data file: missing color or features section", action);
+                displayMessage(DisplayMessage::newErrorMessage(fmt::format("Failed to {} data file", action)));
+            }
+        } catch (const std::exception &e) {
+            mLogger->errorf("Failed to {} data file: {}", action, e.what());
+            displayMessage(DisplayMessage::newErrorMessage(
+                    fmt::format("Failed to {} data file: {}", action, e.what())));
+        }
+        if (mReloadQueued) {
+            startReload();
+        }
+    }
+
     void EuroScopeRenderPlugin::readConfig() {
         std::string logPath = getConfigOrDefault(SETTING_LOG_PATH, DEFAULT_LOG_PATH);
         mConfig->mLogPath = mDllPath.parent_path() / logPath;
@@ -131,6 +287,21 @@ namespace RenderPlugin {
         std::string renderType = getConfigOrDefault(SETTING_RENDER_TYPE, DEFAULT_RENDER_TYPE);
         mConfig->mRenderType = PluginConfig::getRenderType(renderType);
 
+        std::string coordinateStorage = getConfigOrDefault(SETTING_COORDINATE_STORAGE, DEFAULT_COORDINATE_STORAGE);
+        mConfig->mCoordinateStorage = stringToCoordinateStorage(coordinateStorage);
+
+        std::string loadMode = getConfigOrDefault(SETTING_LOAD_MODE, DEFAULT_LOAD_MODE);
+        mConfig->mLoadMode = stringToYamlLoadMode(loadMode);
+
+        std::string binaryCache = getConfigOrDefault(SETTING_BINARY_CACHE, DEFAULT_BINARY_CACHE);
+        mConfig->mBinaryCache = binaryCache == "true" || binaryCache == "1";
+
+        std::string hotReload = getConfigOrDefault(SETTING_HOT_RELOAD, DEFAULT_HOT_RELOAD);
+        mConfig->mHotReload = hotReload == "true" || hotReload == "1";
+
+        std::string deferredLoad = getConfigOrDefault(SETTING_DEFERRED_LOAD, DEFAULT_DEFERRED_LOAD);
+        mConfig->mDeferredLoad = deferredLoad == "true" || deferredLoad == "1";
+
         std::string refZoomStr = getConfigOrDefault(SETTING_TEXT_SIZE_REFERENCE_ZOOM, DEFAULT_TEXT_SIZE_REFERENCE_ZOOM);
         try {
             int z = std::stoi(refZoomStr);
@@ -4,9 +4,11 @@
 #ifndef RENDERPLUGIN_EUROSCOPE_RENDER_PLUGIN_H
 #define RENDERPLUGIN_EUROSCOPE_RENDER_PLUGIN_H
 
+#include <future>
 #include <vector>
 #include "EuroScopePlugIn.h"
 #include "euroscope_render_definition.h"
+#include "file_watcher.h"
 #include "render_data_provider.h"
 #include "render.h"
 #include "radar_render.h"
@@ -41,6 +43,14 @@ namespace RenderPlugin {
         }
     };
 
+    /** 后台加载的结果 */
+    struct LoadResult {
+        // 加载失败时为空
+        ProviderPtr mProvider;
+        // 热重载时源文件内容与当前数据集相同，既未加载也不发布
+        bool mUnchanged{false};
+    };
+
     class EuroScopeRenderPlugin : public EuroScopePlugIn::CPlugIn {
     public:
         EuroScopeRenderPlugin(HMODULE hModule);
@@ -53,6 +63,8 @@ namespace RenderPlugin {
 
         virtual bool OnCompileCommand(const char *sCommandLine) override;
 
+        virtual void OnTimer(int Counter) override;
+
         /** 由 RadarRender 在 OnAsrContentToBeClosed 时调用，用于延迟移除已关闭的屏幕 */
         void notifyRadarScreenClosed(RadarRender *screen);
 
@@ -64,8 +76,36 @@ namespace RenderPlugin {
         ProviderPtr mDataProvider;
         std::vector<std::unique_ptr<RadarRender>> mRadarScreens;
         std::vector<RadarRender *> mRadarScreensToRemove;
+        // 后台加载中的数据集，完成后由 OnTimer 在 UI 线程发布
+        std::future<LoadResult> mPendingReload;
+        bool mReloadQueued{false};
+        // 进行中的加载是插件初始化时的首次加载
+        bool mInitialLoad{false};
+        FileWatcher mFileWatcher{HOT_RELOAD_QUIET_PERIOD};
 
         void removeClosedRadarScreens();
+
+        /** 按当前配置创建数据提供者（不加载数据） */
+        ProviderPtr createDataProvider() const;
+
+        /**
+         * 在后台线程加载数据文件；已有加载进行中时在其完成后再加载一次。
+         * 给出 baseline（热重载）时先在后台比较源文件的内容哈希，内容未变化则不加载
+         */
+        void startReload(std::vector<WatchedFile> baseline = {});
+
+        /** 在后台线程创建并加载新的数据提供者，结果由 pollReload 发布 */
+        void launchLoad(std::vector<WatchedFile> baseline = {});
+
+        /** 后台加载完成时发布新数据集，失败时保留原数据集 */
+        void pollReload();
+
+        /** 热重载开启时以当前数据集的源文件为基准开始监视 */
+        void watchSourceFiles();
+
+        /** 将数据集加载时发现的字段错误（出错的字段或要素已被跳过）和加载提示写入日志 */
+        void logLoadErrors(const RenderDataProvider &provider) const;
+
         void readConfig();
 
         std::string getConfigOrDefault(const std::string &key, const std::string &defaultValue);
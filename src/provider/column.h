@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_COLUMN_H
+#define RENDERPLUGIN_COLUMN_H
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RenderPlugin {
+    /**
+     * 列式存储中的一列。构建期间数据存放在自有的 vector 中；
+     * 也可以通过 attach 直接指向外部只读内存（如内存映射的缓存文件），不做任何复制，此时不能再修改。
+     */
+    template<typename T>
+    class Column {
+        static_assert(std::is_trivially_copyable_v<T>, "column element must be trivially copyable");
+
+    public:
+        Column() = default;
+
+        Column(const Column &other) : mOwned(other.mOwned), mData(other.mData), mSize(other.mSize) {
+            if (!other.isAttached()) {
+                sync();
+            }
+        }
+
+        Column(Column &&other) noexcept: mOwned(std::move(other.mOwned)), mData(other.mData), mSize(other.mSize) {
+            other.mOwned.clear();
+            other.sync();
+        }
+
+        Column &operator=(const Column &other) {
+            if (this != &other) {
+                mOwned = other.mOwned;
+                mData = other.mData;
+                mSize = other.mSize;
+                if (!other.isAttached()) {
+                    sync();
+                }
+            }
+            return *this;
+        }
+
+        Column &operator=(Column &&other) noexcept {
+            if (this != &other) {
+                mOwned = std::move(other.mOwned);
+                mData = other.mData;
+                mSize = other.mSize;
+                other.mOwned.clear();
+                other.sync();
+            }
+            return *this;
+        }
+
+        /** 指向外部内存，调用方负责保证内存在本列的生命周期内有效 */
+        void attach(const T *data, size_t size) {
+            mOwned = std::vector<T>();
+            mData = data;
+            mSize = size;
+        }
+
+        [[nodiscard]] bool isAttached() const { return mData != nullptr && mData != mOwned.data(); }
+
+        void reserve(size_t size) {
+            mOwned.reserve(size);
+            sync();
+        }
+
+        void push_back(const T &value) {
+            mOwned.push_back(value);
+            sync();
+        }
+
+        template<typename... Args>
+        void emplace_back(Args &&...args) {
+            mOwned.emplace_back(std::forward<Args>(args)...);
+            sync();
+        }
+
+        template<typename Iterator>
+        void append(Iterator first, Iterator last) {
+            mOwned.insert(mOwned.end(), first, last);
+            sync();
+        }
+
+        void shrinkToFit() {
+            mOwned.shrink_to_fit();
+            sync();
+        }
+
+        [[nodiscard]] size_t size() const { return mSize; }
+
+        [[nodiscard]] bool empty() const { return mSize == 0; }
+
+        [[nodiscard]] const T *data() const { return mData; }
+
+        const T &operator[](size_t index) const { return mData[index]; }
+
+        [[nodiscard]] const T *begin() const { return mData; }
+
+        [[nodiscard]] const T *end() const { return mData + mSize; }
+
+        [[nodiscard]] std::span<const T> span() const { return {mData, mSize}; }
+
+    private:
+        std::vector<T> mOwned;
+        const T *mData{nullptr};
+        size_t mSize{0};
+
+        void sync() {
+            mData = mOwned.data();
+            mSize = mOwned.size();
+        }
+    };
+}
+
+#endif
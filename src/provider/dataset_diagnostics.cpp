@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <fmt/format.h>
+
+#include "dataset_diagnostics.h"
+
+namespace {
+    using namespace RenderPlugin;
+
+    // 小于此值（平方度，约 1 平方米）的区域视为面积为零
+    constexpr double MIN_AREA = 1e-10;
+
+    bool isHexDigit(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    bool isValidColorLiteral(const std::string &color) {
+        const size_t digits = color.size() - 1;
+        if (digits != 3 && digits != 4 && digits != 6 && digits != 8) {
+            return false;
+        }
+        for (size_t i = 1; i < color.size(); ++i) {
+            if (!isHexDigit(color[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t minimumPoints(RenderType type) {
+        switch (type) {
+            case RenderType::LINE:
+                return 2;
+            case RenderType::AREA:
+                return 3;
+            default:
+                return 1;
+        }
+    }
+
+    /** 鞋带公式求多边形面积（平方度），平移到首点附近计算以减小误差 */
+    double polygonArea(const CoordinateView &coordinates) {
+        const Coordinate origin = coordinates[0];
+        double twiceArea = 0;
+        for (size_t i = 0; i < coordinates.size(); ++i) {
+            const Coordinate a = coordinates[i];
+            const Coordinate b = coordinates[(i + 1) % coordinates.size()];
+            twiceArea += (a.mLongitude - origin.mLongitude) * (b.mLatitude - origin.mLatitude) -
+                         (b.mLongitude - origin.mLongitude) * (a.mLatitude - origin.mLatitude);
+        }
+        return std::abs(twiceArea) / 2;
+    }
+
+    bool allPointsEqual(const CoordinateView &coordinates) {
+        const Coordinate first = coordinates[0];
+        for (const Coordinate point: coordinates) {
+            if (point.mLongitude != first.mLongitude || point.mLatitude != first.mLatitude) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace RenderPlugin {
+    std::string diagnosticKindToString(DiagnosticKind kind) {
+        switch (kind) {
+            case DiagnosticKind::UnknownColor:
+                return "unknown-color";
+            case DiagnosticKind::InvalidColor:
+                return "invalid-color";
+            case DiagnosticKind::TooFewPoints:
+                return "too-few-points";
+            default:
+                return "degenerate-geometry";
+        }
+    }
+
+    std::vector<DatasetDiagnostic> diagnoseDataset(const FeatureStore &store, const ColorMap &colorMap) {
+        std::vector<DatasetDiagnostic> diagnostics;
+        for (FeatureStore::FeatureIndex i = 0; i < store.size(); ++i) {
+            const auto raw = store.rawColors(i);
+            const std::pair<const char *, const std::string &> fields[] = {
+                    {"fill",                 raw.mRawFill},
+                    {"color",                raw.mRawColor},
+                    {"textBackground",       raw.mRawTextBackground},
+                    {"textBackgroundStroke", raw.mRawTextBackgroundStroke}
+            };
+            for (const auto &[field, value]: fields) {
+                if (value.empty()) {
+                    continue;
+                }
+                if (value[0] != '#') {
+                    if (!colorMap.contains(value)) {
+                        diagnostics.push_back({DiagnosticKind::UnknownColor, i,
+                                               fmt::format("{} '{}' is not defined in the color table", field, value)});
+                    }
+                } else if (!isValidColorLiteral(value)) {
+                    diagnostics.push_back({DiagnosticKind::InvalidColor, i,
+                                           fmt::format("{} '{}' is not a valid color literal", field, value)});
+                }
+            }
+
+            const RenderType type = store.type(i);
+            const auto coordinates = store.coordinates(i);
+            const size_t required = minimumPoints(type);
+            if (coordinates.size() < required) {
+                diagnostics.push_back({DiagnosticKind::TooFewPoints, i,
+                                       fmt::format("{} has {} point(s), at least {} required",
+                                                   renderTypeToString(type), coordinates.size(), required)});
+                continue;
+            }
+            if (type == RenderType::AREA && polygonArea(coordinates) < MIN_AREA) {
+                diagnostics.push_back({DiagnosticKind::DegenerateGeometry, i, "area has zero area"});
+            } else if (type == RenderType::LINE && allPointsEqual(coordinates)) {
+                diagnostics.push_back({DiagnosticKind::DegenerateGeometry, i, "line has zero length"});
+            }
+        }
+        return diagnostics;
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_DATASET_DIAGNOSTICS_H
+#define RENDERPLUGIN_DATASET_DIAGNOSTICS_H
+
+#include <string>
+#include <vector>
+
+#include "feature_store.h"
+#include "render_data_definition.hpp"
+
+namespace RenderPlugin {
+    enum class DiagnosticKind : uint8_t {
+        UnknownColor,       // 颜色名称不在 color 表中，按默认颜色绘制
+        InvalidColor,       // 以 # 开头但不是 #RGB / #RGBA / #RRGGBB / #RRGGBBAA
+        TooFewPoints,       // 线少于 2 点、区域少于 3 点、文字没有坐标
+        DegenerateGeometry  // 所有点重合的线、面积为零的区域
+    };
+
+    std::string diagnosticKindToString(DiagnosticKind kind);
+
+    struct DatasetDiagnostic {
+        DiagnosticKind mKind;
+        FeatureStore::FeatureIndex mFeature;
+        std::string mMessage;
+    };
+
+    /** 检查已加载的数据集，这些问题不影响加载，但要素会按默认颜色绘制或不可见 */
+    std::vector<DatasetDiagnostic> diagnoseDataset(const FeatureStore &store, const ColorMap &colorMap);
+}
+
+#endif
@@ -0,0 +1,205 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <limits>
+
+#include "feature_store.h"
+#include "string_utils.h"
+
+namespace RenderPlugin {
+    FeatureStore::FeatureStore(CoordinateStorage storage) : mCoordinateStorage(storage) {
+        mRawColorOffsets.push_back(0);
+        mRawColorOffsets.push_back(0);
+    }
+
+    void FeatureStore::reserve(size_t featureCount, size_t coordinateCount) {
+        mTypes.reserve(featureCount);
+        mZooms.reserve(featureCount);
+        mMaxZooms.reserve(featureCount);
+        mStyleIds.reserve(featureCount);
+        mCoordinateOffsets.reserve(featureCount);
+        mCoordinateCounts.reserve(featureCount);
+        mBounds.reserve(featureCount);
+        mLabels.reserve(featureCount);
+        mRawColorIds.reserve(featureCount * RAW_COLOR_FIELDS);
+        if (mCoordinateStorage == CoordinateStorage::Quantized) {
+            mQuantizedPool.reserve(coordinateCount);
+        } else {
+            mCoordinatePool.reserve(coordinateCount);
+        }
+    }
+
+    FeatureStore::FeatureIndex FeatureStore::append(RenderData &&data) {
+        const auto index = static_cast<FeatureIndex>(mTypes.size());
+
+        FeatureStyle style;
+        style.mFill = data.mFill;
+        style.mColor = data.mColor;
+        style.mTextBackground = data.mTextBackground;
+        style.mTextBackgroundStroke = data.mTextBackgroundStroke;
+        style.mStrokeWidth = data.mStrokeWidth;
+        style.mDashLength = data.mDashLength;
+        style.mGapLength = data.mGapLength;
+        style.mTextBackgroundStrokeWidth = data.mTextBackgroundStrokeWidth;
+        style.mFontSize = data.mFontSize;
+        style.mTextAnchor = data.mTextAnchor;
+        style.mLineStyle = data.mLineStyle;
+        style.mHasColor = !data.mRawColor.empty();
+        style.mHasTextBackground = !data.mRawTextBackground.empty();
+        style.mHasTextBackgroundStroke = !data.mRawTextBackgroundStroke.empty();
+
+        mTypes.push_back(data.mType);
+        // zoom 大于 19 的要素永远不会绘制，maxZoom 大于 19 等同于不限，负数均等同于 0，因此截断到 uint8_t 不改变语义
+        constexpr int zoomLimit = (std::numeric_limits<uint8_t>::max)();
+        mZooms.push_back(static_cast<uint8_t>(std::clamp(data.mZoom, 0, zoomLimit)));
+        mMaxZooms.push_back(static_cast<uint8_t>(std::clamp(data.mMaxZoom, 0, zoomLimit)));
+        mStyleIds.push_back(internStyle(style));
+        mCoordinateOffsets.push_back(static_cast<uint32_t>(coordinateCount()));
+        mCoordinateCounts.push_back(static_cast<uint32_t>(data.mCoordinates.size()));
+        if (mCoordinateStorage == CoordinateStorage::Quantized) {
+            for (const auto &coord: data.mCoordinates) {
+                mQuantizedPool.emplace_back(coord);
+            }
+        } else {
+            mCoordinatePool.append(data.mCoordinates.begin(), data.mCoordinates.end());
+        }
+        // 包围盒按存储后的坐标计算，量化存储时与绘制时解码出的坐标一致
+        GeoRect bounds;
+        for (const auto &coord: coordinates(index)) {
+            bounds.expand(coord.mLongitude, coord.mLatitude);
+        }
+        mBounds.push_back(bounds);
+
+        mLabels.push_back(mLabelTable.intern(data.mText));
+        mRawColorIds.push_back(internRawColor(data.mRawFill));
+        mRawColorIds.push_back(internRawColor(data.mRawColor));
+        mRawColorIds.push_back(internRawColor(data.mRawTextBackground));
+        mRawColorIds.push_back(internRawColor(data.mRawTextBackgroundStroke));
+        return index;
+    }
+
+    void FeatureStore::setSourceHashes(const std::vector<uint64_t> &hashes) {
+        mSourceHashes = Column<uint64_t>();
+        mSourceHashes.append(hashes.begin(), hashes.end());
+    }
+
+    FeatureRawColors FeatureStore::rawColors(FeatureIndex index) const {
+        const uint32_t *ids = mRawColorIds.data() + static_cast<size_t>(index) * RAW_COLOR_FIELDS;
+        return {std::string(rawColor(ids[0])), std::string(rawColor(ids[1])),
+                std::string(rawColor(ids[2])), std::string(rawColor(ids[3]))};
+    }
+
+    RenderData FeatureStore::toRenderData(FeatureIndex index) const {
+        RenderData data;
+        const auto &style = this->style(index);
+        const auto raw = rawColors(index);
+        const auto coords = coordinates(index);
+        data.mType = mTypes[index];
+        data.mCoordinates.assign(coords.begin(), coords.end());
+        data.mRawFill = raw.mRawFill;
+        data.mFill = style.mFill;
+        data.mRawColor = raw.mRawColor;
+        data.mColor = style.mColor;
+        data.mText = WstringToUtf8(std::wstring(text(index)));
+        data.mFontSize = style.mFontSize;
+        data.mTextAnchor = style.mTextAnchor;
+        data.mRawTextBackground = raw.mRawTextBackground;
+        data.mTextBackground = style.mTextBackground;
+        data.mRawTextBackgroundStroke = raw.mRawTextBackgroundStroke;
+        data.mTextBackgroundStroke = style.mTextBackgroundStroke;
+        data.mTextBackgroundStrokeWidth = style.mTextBackgroundStrokeWidth;
+        data.mZoom = mZooms[index];
+        data.mMaxZoom = mMaxZooms[index];
+        data.mLineStyle = style.mLineStyle;
+        data.mStrokeWidth = style.mStrokeWidth;
+        data.mDashLength = style.mDashLength;
+        data.mGapLength = style.mGapLength;
+        return data;
+    }
+
+    void FeatureStore::finalize() {
+        mStyleLookup = {};
+        mRawColorLookup = {};
+        mLabelTable.finalize();
+        mTiles.build(mBounds.span(), mZooms.span(), mMaxZooms.span());
+    }
+
+    FeatureStore::StyleId FeatureStore::internStyle(const FeatureStyle &style) {
+        auto it = mStyleLookup.find(style);
+        if (it != mStyleLookup.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<StyleId>(mStyles.size());
+        mStyles.push_back(style);
+        mStyleLookup.emplace(style, id);
+        return id;
+    }
+
+    uint32_t FeatureStore::internRawColor(std::string_view rawColor) {
+        if (rawColor.empty()) {
+            return 0;
+        }
+        std::string key(rawColor);
+        auto it = mRawColorLookup.find(key);
+        if (it != mRawColorLookup.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<uint32_t>(mRawColorOffsets.size() - 1);
+        mRawColorArena.append(rawColor.begin(), rawColor.end());
+        mRawColorOffsets.push_back(static_cast<uint32_t>(mRawColorArena.size()));
+        mRawColorLookup.emplace(std::move(key), id);
+        return id;
+    }
+
+    FeatureImporter::FeatureImporter(FeatureStore &target, const FeatureStore &source) :
+            mTarget(target), mSource(source), mStyleMapping(source.mStyles.size(), UNMAPPED),
+            mLabelMapping(source.mLabelTable.size(), UNMAPPED), mRawColorMapping(source.mRawColorOffsets.size() - 1,
+                                                                                  UNMAPPED) {}
+
+    FeatureStore::FeatureIndex FeatureImporter::import(FeatureStore::FeatureIndex index) {
+        FeatureStore &target = mTarget;
+        const FeatureStore &source = mSource;
+        const auto targetIndex = static_cast<FeatureStore::FeatureIndex>(target.size());
+
+        auto &styleId = mStyleMapping[source.mStyleIds[index]];
+        if (styleId == UNMAPPED) {
+            FeatureStyle style = source.mStyles[source.mStyleIds[index]];
+            style.mFill = target.mPalette.intern(source.mPalette[style.mFill]);
+            style.mColor = target.mPalette.intern(source.mPalette[style.mColor]);
+            style.mTextBackground = target.mPalette.intern(source.mPalette[style.mTextBackground]);
+            style.mTextBackgroundStroke = target.mPalette.intern(source.mPalette[style.mTextBackgroundStroke]);
+            styleId = target.internStyle(style);
+        }
+        auto &label = mLabelMapping[source.mLabels[index]];
+        if (label == UNMAPPED) {
+            label = target.mLabelTable.internWide(source.text(index));
+        }
+
+        target.mTypes.push_back(source.mTypes[index]);
+        target.mZooms.push_back(source.mZooms[index]);
+        target.mMaxZooms.push_back(source.mMaxZooms[index]);
+        target.mStyleIds.push_back(styleId);
+        target.mCoordinateOffsets.push_back(static_cast<uint32_t>(target.coordinateCount()));
+        target.mCoordinateCounts.push_back(source.mCoordinateCounts[index]);
+        const size_t first = source.mCoordinateOffsets[index];
+        const size_t last = first + source.mCoordinateCounts[index];
+        if (target.mCoordinateStorage == CoordinateStorage::Quantized) {
+            target.mQuantizedPool.append(source.mQuantizedPool.begin() + first, source.mQuantizedPool.begin() + last);
+        } else {
+            target.mCoordinatePool.append(source.mCoordinatePool.begin() + first,
+                                          source.mCoordinatePool.begin() + last);
+        }
+        target.mBounds.push_back(source.mBounds[index]);
+        target.mLabels.push_back(label);
+        const uint32_t *rawIds = source.mRawColorIds.data() + static_cast<size_t>(index) * FeatureStore::RAW_COLOR_FIELDS;
+        for (size_t field = 0; field < FeatureStore::RAW_COLOR_FIELDS; ++field) {
+            auto &rawId = mRawColorMapping[rawIds[field]];
+            if (rawId == UNMAPPED) {
+                rawId = target.internRawColor(source.rawColor(rawIds[field]));
+            }
+            target.mRawColorIds.push_back(rawId);
+        }
+        return targetIndex;
+    }
+}
@@ -0,0 +1,289 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_FEATURE_STORE_H
+#define RENDERPLUGIN_FEATURE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "column.h"
+#include "geometry_definition.hpp"
+#include "label_table.h"
+#include "palette.h"
+#include "render_data_definition.hpp"
+#include "tile_pyramid.h"
+
+namespace RenderPlugin {
+    /** 要素的绘制样式，相同样式的要素共享同一条记录；颜色均为调色板下标 */
+    struct FeatureStyle {
+        PaletteIndex mFill{};
+        PaletteIndex mColor{};
+        PaletteIndex mTextBackground{};
+        PaletteIndex mTextBackgroundStroke{};
+        float mStrokeWidth{0.0f};   // 0 = use default (1.0 solid, 2.0 dashed)
+        float mDashLength{0.0f};    // 0 = use default (10.0)
+        float mGapLength{0.0f};     // 0 = use default (6.0)
+        float mTextBackgroundStrokeWidth{2.0f};
+        int mFontSize{};
+        TextAnchor mTextAnchor{TextAnchor::TopLeft};
+        LineStyle mLineStyle{LineStyle::Solid};
+        bool mHasColor{false};                  // 配置了 color（区域据此决定是否绘制边框）
+        bool mHasTextBackground{false};         // 配置了 textBackground
+        bool mHasTextBackgroundStroke{false};   // 配置了 textBackgroundStroke
+
+        auto operator<=>(const FeatureStyle &) const = default;
+    };
+
+    /** 要素的原始颜色字段，仅在导出等非热路径使用 */
+    struct FeatureRawColors {
+        std::string mRawFill{};
+        std::string mRawColor{};
+        std::string mRawTextBackground{};
+        std::string mRawTextBackgroundStroke{};
+    };
+
+    /**
+     * 单个要素的坐标视图。两种存储方式共用同一接口，量化坐标在读取时直接解码为 double，
+     * 不会生成临时数组。
+     */
+    class CoordinateView {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Coordinate;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Coordinate;
+
+            Iterator() = default;
+
+            Iterator(const CoordinateView *view, size_t index) : mView(view), mIndex(index) {}
+
+            Coordinate operator*() const { return (*mView)[mIndex]; }
+
+            Iterator &operator++() {
+                ++mIndex;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator tmp = *this;
+                ++mIndex;
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const { return mIndex == other.mIndex; }
+
+        private:
+            const CoordinateView *mView{nullptr};
+            size_t mIndex{0};
+        };
+
+        CoordinateView() = default;
+
+        CoordinateView(const Coordinate *coordinates, uint32_t count) : mDoubles(coordinates), mCount(count) {}
+
+        CoordinateView(const QuantizedCoordinate *coordinates, uint32_t count)
+                : mQuantized(coordinates), mCount(count) {}
+
+        [[nodiscard]] size_t size() const { return mCount; }
+
+        [[nodiscard]] bool empty() const { return mCount == 0; }
+
+        Coordinate operator[](size_t index) const {
+            return mQuantized != nullptr ? mQuantized[index].toCoordinate() : mDoubles[index];
+        }
+
+        [[nodiscard]] Iterator begin() const { return {this, 0}; }
+
+        [[nodiscard]] Iterator end() const { return {this, mCount}; }
+
+    private:
+        const Coordinate *mDoubles{nullptr};
+        const QuantizedCoordinate *mQuantized{nullptr};
+        uint32_t mCount{0};
+    };
+
+    /**
+     * 列式（struct-of-arrays）要素存储。
+     * 每帧遍历的热数据（类型、缩放等级、样式 ID、包围盒、坐标区间）按列连续存放，
+     * 所有要素的坐标放在同一个坐标池中，以偏移量 + 数量引用，坐标池可选择 double 或 int32 量化存储；
+     * 原始字符串、文字内容等冷数据单独存放，遍历时不会被载入缓存。
+     * 所有列既可以由加载过程构建，也可以直接指向内存映射的二进制缓存（见 feature_store_binary.h）。
+     */
+    class FeatureStore {
+    public:
+        using FeatureIndex = uint32_t;
+        using StyleId = uint32_t;
+
+        explicit FeatureStore(CoordinateStorage storage = CoordinateStorage::Double);
+
+        [[nodiscard]] CoordinateStorage coordinateStorage() const { return mCoordinateStorage; }
+
+        void reserve(size_t featureCount, size_t coordinateCount);
+
+        /** 追加一个颜色已解析的要素，返回其下标；要素顺序即绘制顺序 */
+        FeatureIndex append(RenderData &&data);
+
+        [[nodiscard]] size_t size() const { return mTypes.size(); }
+
+        [[nodiscard]] bool empty() const { return mTypes.empty(); }
+
+        [[nodiscard]] size_t coordinateCount() const {
+            return mCoordinateStorage == CoordinateStorage::Quantized ? mQuantizedPool.size() : mCoordinatePool.size();
+        }
+
+        [[nodiscard]] size_t styleCount() const { return mStyles.size(); }
+
+        /** 要素样式中的颜色下标均指向此调色板 */
+        [[nodiscard]] const Palette &palette() const { return mPalette; }
+
+        void setPalette(Palette palette) { mPalette = std::move(palette); }
+
+        /** 文字要素的标签均存放在此字符串表中 */
+        [[nodiscard]] const LabelTable &labels() const { return mLabelTable; }
+
+        /** 加载结束后调用，释放仅在构建期间使用的查找表并构建瓦片金字塔 */
+        void finalize();
+
+        /**
+         * 将在缩放等级 zoom 下可见（见 isZoomVisible）且包围盒与 rect 相交的要素下标按绘制顺序追加到 out，
+         * 开销取决于视野内可见的要素数而非数据集大小；存储未经 finalize 时逐个检查全部要素
+         */
+        void queryFeatures(const GeoRect &rect, int zoom, std::vector<FeatureIndex> &out) const {
+            mTiles.query(rect, zoom, mBounds.span(), mZooms.span(), mMaxZooms.span(), out);
+        }
+
+        /**
+         * 每个要素源文本的哈希（与要素一一对应），增量重新加载时据此找出未变化的要素；
+         * 加载方式不支持时为空
+         */
+        [[nodiscard]] std::span<const uint64_t> sourceHashes() const { return mSourceHashes.span(); }
+
+        void setSourceHashes(const std::vector<uint64_t> &hashes);
+
+        /** 解析颜色时所用颜色表的哈希，颜色表不同时源文本相同的要素颜色也可能不同 */
+        [[nodiscard]] uint64_t colorTableHash() const { return mColorTableHash; }
+
+        void setColorTableHash(uint64_t hash) { mColorTableHash = hash; }
+
+        /** 数据文件 include 的其他文件（原文，UTF-8，相对该文件所在目录）；存储只含该文件自身的要素 */
+        [[nodiscard]] const std::vector<std::string> &includes() const { return mIncludes; }
+
+        void setIncludes(std::vector<std::string> includes) { mIncludes = std::move(includes); }
+
+        // hot columns
+
+        [[nodiscard]] RenderType type(FeatureIndex index) const { return mTypes[index]; }
+
+        [[nodiscard]] int zoom(FeatureIndex index) const { return mZooms[index]; }
+
+        /** 最大缩放等级，0 表示不限 */
+        [[nodiscard]] int maxZoom(FeatureIndex index) const { return mMaxZooms[index]; }
+
+        [[nodiscard]] StyleId styleId(FeatureIndex index) const { return mStyleIds[index]; }
+
+        [[nodiscard]] const FeatureStyle &style(FeatureIndex index) const { return mStyles[mStyleIds[index]]; }
+
+        /** 要素所有坐标的经纬度包围盒，加载时计算；没有坐标的要素为空矩形 */
+        [[nodiscard]] const GeoRect &bounds(FeatureIndex index) const { return mBounds[index]; }
+
+        [[nodiscard]] CoordinateView coordinates(FeatureIndex index) const {
+            if (mCoordinateStorage == CoordinateStorage::Quantized) {
+                return {mQuantizedPool.data() + mCoordinateOffsets[index], mCoordinateCounts[index]};
+            }
+            return {mCoordinatePool.data() + mCoordinateOffsets[index], mCoordinateCounts[index]};
+        }
+
+        // cold columns
+
+        [[nodiscard]] LabelHandle label(FeatureIndex index) const { return mLabels[index]; }
+
+        [[nodiscard]] std::wstring_view text(FeatureIndex index) const { return mLabelTable.get(mLabels[index]); }
+
+        [[nodiscard]] FeatureRawColors rawColors(FeatureIndex index) const;
+
+        /** 还原为 RenderData，用于导出等非热路径 */
+        [[nodiscard]] RenderData toRenderData(FeatureIndex index) const;
+
+    private:
+        friend class FeatureStoreBinary;
+        friend class FeatureImporter;
+
+        // 每个要素的原始颜色字段数：fill、color、textBackground、textBackgroundStroke
+        static constexpr size_t RAW_COLOR_FIELDS = 4;
+
+        // hot
+        CoordinateStorage mCoordinateStorage;
+        Column<RenderType> mTypes;
+        Column<uint8_t> mZooms;
+        Column<uint8_t> mMaxZooms;
+        Column<StyleId> mStyleIds;
+        Column<uint32_t> mCoordinateOffsets;
+        Column<uint32_t> mCoordinateCounts;
+        Column<GeoRect> mBounds;
+        Column<Coordinate> mCoordinatePool;          // CoordinateStorage::Double
+        Column<QuantizedCoordinate> mQuantizedPool;  // CoordinateStorage::Quantized
+        Column<FeatureStyle> mStyles;
+        Palette mPalette;
+        TilePyramid mTiles;
+        // cold
+        Column<LabelHandle> mLabels;
+        LabelTable mLabelTable;
+        // 原始颜色字符串去重后连续存放，第 i 个字符串占用 [mRawColorOffsets[i], mRawColorOffsets[i + 1])，0 为空字符串
+        Column<uint32_t> mRawColorIds;               // 每个要素 RAW_COLOR_FIELDS 个
+        Column<char> mRawColorArena;
+        Column<uint32_t> mRawColorOffsets;
+        Column<uint64_t> mSourceHashes;
+        uint64_t mColorTableHash{0};
+        std::vector<std::string> mIncludes;
+        std::map<FeatureStyle, StyleId> mStyleLookup;
+        std::unordered_map<std::string, uint32_t> mRawColorLookup;
+        // 列指向外部内存时持有其所有者（如映射的缓存文件）
+        std::shared_ptr<const void> mBacking;
+
+        StyleId internStyle(const FeatureStyle &style);
+
+        uint32_t internRawColor(std::string_view rawColor);
+
+        [[nodiscard]] std::string_view rawColor(uint32_t id) const {
+            return {mRawColorArena.data() + mRawColorOffsets[id], mRawColorOffsets[id + 1] - mRawColorOffsets[id]};
+        }
+    };
+
+    using FeatureStorePtr = std::shared_ptr<FeatureStore>;
+
+    /**
+     * 把另一个存储中的要素逐个复制到目标存储末尾，不重新解码：坐标、包围盒原样复制，
+     * 样式（含调色板下标）、文字标签和原始颜色按需重新映射，映射结果缓存，每种只转换一次。
+     * 两者的坐标存储方式必须相同；导入期间源存储不能修改。
+     */
+    class FeatureImporter {
+    public:
+        FeatureImporter(FeatureStore &target, const FeatureStore &source);
+
+        FeatureStore::FeatureIndex import(FeatureStore::FeatureIndex index);
+
+    private:
+        static constexpr uint32_t UNMAPPED = UINT32_MAX;
+
+        FeatureStore &mTarget;
+        const FeatureStore &mSource;
+        std::vector<FeatureStore::StyleId> mStyleMapping;
+        std::vector<LabelHandle> mLabelMapping;
+        std::vector<uint32_t> mRawColorMapping;
+    };
+}
+
+#endif
@@ -0,0 +1,393 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "feature_store_binary.h"
+#include "hash_utils.h"
+#include "mapped_file.h"
+
+namespace {
+    using namespace RenderPlugin;
+
+    constexpr char MAGIC[8] = {'E', 'R', 'P', 'B', 'I', 'N', '\0', '\0'};
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr uint64_t SECTION_ALIGNMENT = 8;
+
+    enum Section : uint32_t {
+        TYPES,
+        ZOOMS,
+        MAX_ZOOMS,
+        STYLE_IDS,
+        COORDINATE_OFFSETS,
+        COORDINATE_COUNTS,
+        BOUNDS,
+        COORDINATES,
+        STYLES,
+        PALETTE,
+        LABELS,
+        LABEL_ARENA,
+        LABEL_OFFSETS,
+        RAW_COLOR_IDS,
+        RAW_COLOR_ARENA,
+        RAW_COLOR_OFFSETS,
+        SOURCE_HASHES,
+        INCLUDES,
+        TILE_KEYS,
+        TILE_OFFSETS,
+        TILE_ITEMS,
+        SECTION_COUNT
+    };
+
+    struct SectionEntry {
+        uint64_t mOffset;   // 相对文件开头的字节偏移
+        uint64_t mCount;    // 元素个数
+    };
+
+    struct Header {
+        char mMagic[8];
+        uint32_t mVersion;
+        uint32_t mByteOrder;
+        uint64_t mLayout;
+        uint64_t mSourceHash;
+        uint64_t mColorTableHash;
+        uint32_t mCoordinateStorage;
+        uint32_t mFeatureCount;
+        SectionEntry mSections[SECTION_COUNT];
+    };
+
+    static_assert(sizeof(Header) % SECTION_ALIGNMENT == 0);
+
+    /** 各记录类型的大小和 FeatureStyle 的字段偏移，编译器或结构变化时缓存自动失效 */
+    uint64_t layoutSignature() {
+        const uint64_t values[] = {
+                sizeof(RenderType), sizeof(GeoRect), sizeof(Coordinate), sizeof(QuantizedCoordinate),
+                sizeof(Color), sizeof(wchar_t), sizeof(FeatureStyle),
+                offsetof(FeatureStyle, mFill), offsetof(FeatureStyle, mColor),
+                offsetof(FeatureStyle, mTextBackground), offsetof(FeatureStyle, mTextBackgroundStroke),
+                offsetof(FeatureStyle, mStrokeWidth), offsetof(FeatureStyle, mDashLength),
+                offsetof(FeatureStyle, mGapLength), offsetof(FeatureStyle, mTextBackgroundStrokeWidth),
+                offsetof(FeatureStyle, mFontSize), offsetof(FeatureStyle, mTextAnchor),
+                offsetof(FeatureStyle, mLineStyle), offsetof(FeatureStyle, mHasColor),
+                offsetof(FeatureStyle, mHasTextBackground), offsetof(FeatureStyle, mHasTextBackgroundStroke)
+        };
+        return hashBytes(values, sizeof(values));
+    }
+
+    uint64_t alignUp(uint64_t value) {
+        return (value + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+    }
+
+    template<typename T>
+    bool readSection(const MappedFile &file, const SectionEntry &entry, std::span<const T> &out) {
+        if (entry.mOffset % alignof(T) != 0 || entry.mOffset > file.size() ||
+            entry.mCount > (file.size() - entry.mOffset) / sizeof(T)) {
+            return false;
+        }
+        out = {reinterpret_cast<const T *>(file.data() + entry.mOffset), static_cast<size_t>(entry.mCount)};
+        return true;
+    }
+
+    /** 字符串表的偏移数组：至少两项、单调不减且不越过字符区 */
+    bool validOffsets(std::span<const uint32_t> offsets, size_t arenaSize) {
+        if (offsets.size() < 2 || offsets[0] != 0) {
+            return false;
+        }
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            if (offsets[i] < offsets[i - 1]) {
+                return false;
+            }
+        }
+        return offsets.back() <= arenaSize;
+    }
+
+    template<typename T>
+    bool allBelow(std::span<const T> values, size_t limit) {
+        for (const T value: values) {
+            if (static_cast<size_t>(value) >= limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * 同目录下的临时文件名，带本进程的随机标识和写入序号：
+     * 多个 EuroScope 实例或同一进程的多个线程同时重写同一缓存时不会写入同一个临时文件
+     */
+    fs::path temporaryPath(const fs::path &path) {
+        static const uint64_t processToken = (uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+        static std::atomic<uint64_t> sequence{0};
+        fs::path temporary = path;
+        temporary += "." + std::to_string(processToken) + "." + std::to_string(sequence.fetch_add(1)) + ".tmp";
+        return temporary;
+    }
+}
+
+namespace RenderPlugin {
+    bool FeatureStoreBinary::write(const FeatureStore &store, uint64_t sourceHash, const fs::path &path) {
+        std::error_code ignored;
+        return write(store, sourceHash, path, ignored);
+    }
+
+    bool FeatureStoreBinary::write(const FeatureStore &store, uint64_t sourceHash, const fs::path &path,
+                                   std::error_code &error) {
+        error.clear();
+        struct Blob {
+            const void *mData;
+            uint64_t mCount;
+            size_t mElementSize;
+        };
+        auto blob = [](const auto &column) {
+            return Blob{column.data(), column.size(), sizeof(*column.data())};
+        };
+
+        // include paths, each terminated by '\0'
+        std::string includes;
+        for (const auto &include: store.mIncludes) {
+            includes.append(include);
+            includes.push_back('\0');
+        }
+
+        Blob blobs[SECTION_COUNT] = {
+                blob(store.mTypes),
+                blob(store.mZooms),
+                blob(store.mMaxZooms),
+                blob(store.mStyleIds),
+                blob(store.mCoordinateOffsets),
+                blob(store.mCoordinateCounts),
+                blob(store.mBounds),
+                store.mCoordinateStorage == CoordinateStorage::Quantized ? blob(store.mQuantizedPool)
+                                                                         : blob(store.mCoordinatePool),
+                blob(store.mStyles),
+                blob(store.mPalette.colors()),
+                blob(store.mLabels),
+                blob(store.mLabelTable.mArena),
+                blob(store.mLabelTable.mOffsets),
+                blob(store.mRawColorIds),
+                blob(store.mRawColorArena),
+                blob(store.mRawColorOffsets),
+                blob(store.mSourceHashes),
+                {includes.data(), includes.size(), 1},
+                blob(store.mTiles.mTileKeys),
+                blob(store.mTiles.mTileOffsets),
+                blob(store.mTiles.mItems)
+        };
+
+        Header header{};
+        std::memcpy(header.mMagic, MAGIC, sizeof(MAGIC));
+        header.mVersion = VERSION;
+        header.mByteOrder = BYTE_ORDER_MARK;
+        header.mLayout = layoutSignature();
+        header.mSourceHash = sourceHash;
+        header.mColorTableHash = store.mColorTableHash;
+        header.mCoordinateStorage = static_cast<uint32_t>(store.mCoordinateStorage);
+        header.mFeatureCount = static_cast<uint32_t>(store.size());
+        uint64_t offset = alignUp(sizeof(Header));
+        for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+            header.mSections[i] = {offset, blobs[i].mCount};
+            offset = alignUp(offset + blobs[i].mCount * blobs[i].mElementSize);
+        }
+
+        // write to a temporary file first so a reader never sees a partially written cache
+        const fs::path temporary = temporaryPath(path);
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                error = std::error_code(errno != 0 ? errno : EIO, std::generic_category());
+                return false;
+            }
+            static const char PADDING[SECTION_ALIGNMENT] = {};
+            out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+            uint64_t written = sizeof(Header);
+            for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+                out.write(PADDING, static_cast<std::streamsize>(header.mSections[i].mOffset - written));
+                const uint64_t size = blobs[i].mCount * blobs[i].mElementSize;
+                if (size > 0) {
+                    out.write(static_cast<const char *>(blobs[i].mData), static_cast<std::streamsize>(size));
+                }
+                written = header.mSections[i].mOffset + size;
+            }
+            out.write(PADDING, static_cast<std::streamsize>(offset - written));
+            if (!out.flush()) {
+                out.close();
+                error = std::make_error_code(std::errc::io_error);
+                std::error_code ignored;
+                fs::remove(temporary, ignored);
+                return false;
+            }
+        }
+        fs::rename(temporary, path, error);
+        if (error) {
+            std::error_code ignored;
+            fs::remove(temporary, ignored);
+            return false;
+        }
+        return true;
+    }
+
+    FeatureStorePtr FeatureStoreBinary::load(const fs::path &path, uint64_t sourceHash, CoordinateStorage storage) {
+        return load(MappedFile::open(path), std::optional<uint64_t>(sourceHash),
+                    std::optional<CoordinateStorage>(storage));
+    }
+
+    FeatureStorePtr FeatureStoreBinary::load(const fs::path &path) {
+        return load(MappedFile::open(path), std::nullopt, std::nullopt);
+    }
+
+    FeatureStorePtr FeatureStoreBinary::load(std::shared_ptr<const MappedFile> file) {
+        return load(std::move(file), std::nullopt, std::nullopt);
+    }
+
+    FeatureStorePtr FeatureStoreBinary::load(std::shared_ptr<const MappedFile> file,
+                                             std::optional<uint64_t> sourceHash,
+                                             std::optional<CoordinateStorage> expectedStorage) {
+        if (!file || file->size() < sizeof(Header)) {
+            return nullptr;
+        }
+        Header header{};
+        std::memcpy(&header, file->data(), sizeof(Header));
+        if (std::memcmp(header.mMagic, MAGIC, sizeof(MAGIC)) != 0 || header.mVersion != VERSION ||
+            header.mByteOrder != BYTE_ORDER_MARK || header.mLayout != layoutSignature() ||
+            (sourceHash && header.mSourceHash != *sourceHash)) {
+            return nullptr;
+        }
+        if (header.mCoordinateStorage != static_cast<uint32_t>(CoordinateStorage::Double) &&
+            header.mCoordinateStorage != static_cast<uint32_t>(CoordinateStorage::Quantized)) {
+            return nullptr;
+        }
+        const auto storage = static_cast<CoordinateStorage>(header.mCoordinateStorage);
+        if (expectedStorage && storage != *expectedStorage) {
+            return nullptr;
+        }
+
+        std::span<const RenderType> types;
+        std::span<const uint8_t> zooms;
+        std::span<const uint8_t> maxZooms;
+        std::span<const FeatureStore::StyleId> styleIds;
+        std::span<const uint32_t> coordinateOffsets;
+        std::span<const uint32_t> coordinateCounts;
+        std::span<const GeoRect> bounds;
+        std::span<const Coordinate> coordinates;
+        std::span<const QuantizedCoordinate> quantized;
+        std::span<const FeatureStyle> styles;
+        std::span<const Color> palette;
+        std::span<const LabelHandle> labels;
+        std::span<const wchar_t> labelArena;
+        std::span<const uint32_t> labelOffsets;
+        std::span<const uint32_t> rawColorIds;
+        std::span<const char> rawColorArena;
+        std::span<const uint32_t> rawColorOffsets;
+        std::span<const uint64_t> sourceHashes;
+        std::span<const char> includes;
+        std::span<const uint64_t> tileKeys;
+        std::span<const uint32_t> tileOffsets;
+        std::span<const uint32_t> tileItems;
+        const auto &sections = header.mSections;
+        const bool quantizedStorage = storage == CoordinateStorage::Quantized;
+        if (!readSection(*file, sections[TYPES], types) ||
+            !readSection(*file, sections[ZOOMS], zooms) ||
+            !readSection(*file, sections[MAX_ZOOMS], maxZooms) ||
+            !readSection(*file, sections[STYLE_IDS], styleIds) ||
+            !readSection(*file, sections[COORDINATE_OFFSETS], coordinateOffsets) ||
+            !readSection(*file, sections[COORDINATE_COUNTS], coordinateCounts) ||
+            !readSection(*file, sections[BOUNDS], bounds) ||
+            !(quantizedStorage ? readSection(*file, sections[COORDINATES], quantized)
+                               : readSection(*file, sections[COORDINATES], coordinates)) ||
+            !readSection(*file, sections[STYLES], styles) ||
+            !readSection(*file, sections[PALETTE], palette) ||
+            !readSection(*file, sections[LABELS], labels) ||
+            !readSection(*file, sections[LABEL_ARENA], labelArena) ||
+            !readSection(*file, sections[LABEL_OFFSETS], labelOffsets) ||
+            !readSection(*file, sections[RAW_COLOR_IDS], rawColorIds) ||
+            !readSection(*file, sections[RAW_COLOR_ARENA], rawColorArena) ||
+            !readSection(*file, sections[RAW_COLOR_OFFSETS], rawColorOffsets) ||
+            !readSection(*file, sections[SOURCE_HASHES], sourceHashes) ||
+            !readSection(*file, sections[INCLUDES], includes) || (!includes.empty() && includes.back() != '\0') ||
+            !readSection(*file, sections[TILE_KEYS], tileKeys) ||
+            !readSection(*file, sections[TILE_OFFSETS], tileOffsets) ||
+            !readSection(*file, sections[TILE_ITEMS], tileItems)) {
+            return nullptr;
+        }
+
+        // structural checks, so that a damaged file can never cause an out of range read while drawing
+        const size_t featureCount = header.mFeatureCount;
+        const size_t coordinateCount = quantizedStorage ? quantized.size() : coordinates.size();
+        if (types.size() != featureCount || zooms.size() != featureCount ||
+            maxZooms.size() != featureCount || styleIds.size() != featureCount ||
+            coordinateOffsets.size() != featureCount || coordinateCounts.size() != featureCount ||
+            bounds.size() != featureCount || labels.size() != featureCount ||
+            rawColorIds.size() != featureCount * FeatureStore::RAW_COLOR_FIELDS ||
+            (!sourceHashes.empty() && sourceHashes.size() != featureCount) ||
+            palette.empty() || palette.size() > Palette::MAX_SIZE || palette[0] != Color() ||
+            !validOffsets(labelOffsets, labelArena.size()) || !validOffsets(rawColorOffsets, rawColorArena.size()) ||
+            !allBelow(styleIds, styles.size()) || !allBelow(labels, labelOffsets.size() - 1) ||
+            !allBelow(rawColorIds, rawColorOffsets.size() - 1)) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < featureCount; ++i) {
+            if (coordinateOffsets[i] > coordinateCount || coordinateCounts[i] > coordinateCount - coordinateOffsets[i]) {
+                return nullptr;
+            }
+        }
+        for (const auto &style: styles) {
+            if (style.mFill >= palette.size() || style.mColor >= palette.size() ||
+                style.mTextBackground >= palette.size() || style.mTextBackgroundStroke >= palette.size()) {
+                return nullptr;
+            }
+        }
+
+        auto store = std::make_shared<FeatureStore>(storage);
+        store->mTypes.attach(types.data(), types.size());
+        store->mZooms.attach(zooms.data(), zooms.size());
+        store->mMaxZooms.attach(maxZooms.data(), maxZooms.size());
+        store->mStyleIds.attach(styleIds.data(), styleIds.size());
+        store->mCoordinateOffsets.attach(coordinateOffsets.data(), coordinateOffsets.size());
+        store->mCoordinateCounts.attach(coordinateCounts.data(), coordinateCounts.size());
+        store->mBounds.attach(bounds.data(), bounds.size());
+        if (quantizedStorage) {
+            store->mQuantizedPool.attach(quantized.data(), quantized.size());
+        } else {
+            store->mCoordinatePool.attach(coordinates.data(), coordinates.size());
+        }
+        store->mStyles.attach(styles.data(), styles.size());
+        store->mLabels.attach(labels.data(), labels.size());
+        store->mLabelTable.mArena.attach(labelArena.data(), labelArena.size());
+        store->mLabelTable.mOffsets.attach(labelOffsets.data(), labelOffsets.size());
+        store->mRawColorIds.attach(rawColorIds.data(), rawColorIds.size());
+        store->mRawColorArena.attach(rawColorArena.data(), rawColorArena.size());
+        store->mRawColorOffsets.attach(rawColorOffsets.data(), rawColorOffsets.size());
+        store->mSourceHashes.attach(sourceHashes.data(), sourceHashes.size());
+        store->mTiles.mTileKeys.attach(tileKeys.data(), tileKeys.size());
+        store->mTiles.mTileOffsets.attach(tileOffsets.data(), tileOffsets.size());
+        store->mTiles.mItems.attach(tileItems.data(), tileItems.size());
+        if (!store->mTiles.valid(featureCount)) {
+            return nullptr;
+        }
+        store->mColorTableHash = header.mColorTableHash;
+        for (size_t begin = 0; begin < includes.size();) {
+            const size_t end = std::find(includes.begin() + begin, includes.end(), '\0') - includes.begin();
+            store->mIncludes.emplace_back(includes.data() + begin, end - begin);
+            begin = end + 1;
+        }
+        // the palette is tiny and renderers keep a reference to its vector, so it is copied
+        for (size_t i = 1; i < palette.size(); ++i) {
+            store->mPalette.intern(palette[i]);
+        }
+        if (store->mPalette.size() != palette.size()) {
+            return nullptr;
+        }
+        store->mBacking = std::move(file);
+        return store;
+    }
+}
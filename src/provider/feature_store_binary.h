@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_FEATURE_STORE_BINARY_H
+#define RENDERPLUGIN_FEATURE_STORE_BINARY_H
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <system_error>
+
+#include "feature_store.h"
+#include "mapped_file.h"
+
+namespace RenderPlugin {
+    namespace fs = std::filesystem;
+
+    /** 编译后二进制数据集的扩展名 */
+    constexpr auto BINARY_DATASET_EXTENSION = ".erpbin";
+
+    /**
+     * 编译后的二进制数据集（.erpbin）。
+     * 文件由固定头部和若干 8 字节对齐的段组成，每段即 FeatureStore 的一列（含瓦片金字塔）原样写出，
+     * 读取时只读映射整个文件，各列直接指向映射内存，不做反序列化；仅调色板按值复制。
+     * 映射的页面即系统文件缓存的页面，同一台机器上打开同一文件的多个进程共用同一份物理内存。
+     * 头部记录格式版本、字节序、记录布局签名、坐标存储方式和源文件哈希，任一不符即视为失效。
+     * FeatureStore 的列或解码语义变化时必须提升 VERSION。
+     */
+    class FeatureStoreBinary {
+    public:
+        static constexpr uint32_t VERSION = 6;
+
+        /**
+         * 写入文件：先写入同目录下本次写入独有的临时文件再替换，失败返回 false 并在 error 中给出原因，原文件不变。
+         * Windows 上目标文件正被其他进程映射时无法替换，同样返回 false
+         */
+        static bool write(const FeatureStore &store, uint64_t sourceHash, const fs::path &path,
+                          std::error_code &error);
+
+        /** 同上，不关心失败原因 */
+        static bool write(const FeatureStore &store, uint64_t sourceHash, const fs::path &path);
+
+        /**
+         * 映射文件并在映射内存上构建存储。
+         * 文件不存在、格式或布局不符、坐标存储方式不同、源文件哈希不匹配或数据不一致时返回 nullptr
+         */
+        static FeatureStorePtr load(const fs::path &path, uint64_t sourceHash, CoordinateStorage storage);
+
+        /** 直接发布的编译数据集（不随源文件分发），不校验源文件哈希，坐标存储方式以文件为准 */
+        static FeatureStorePtr load(const fs::path &path);
+
+        /** 同上，使用调用方已映射的文件（如已对其计算哈希），存储持有该映射 */
+        static FeatureStorePtr load(std::shared_ptr<const MappedFile> file);
+
+    private:
+        static FeatureStorePtr load(std::shared_ptr<const MappedFile> file, std::optional<uint64_t> sourceHash,
+                                    std::optional<CoordinateStorage> storage);
+    };
+}
+
+#endif
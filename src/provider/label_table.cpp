@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include "label_table.h"
+#include "string_utils.h"
+
+namespace RenderPlugin {
+    LabelTable::LabelTable() {
+        mOffsets.push_back(0);
+        mOffsets.push_back(0);
+    }
+
+    LabelHandle LabelTable::intern(std::string_view utf8) {
+        if (utf8.empty()) {
+            return EMPTY_LABEL;
+        }
+        auto it = mLookup.find(utf8);
+        if (it != mLookup.end()) {
+            return it->second;
+        }
+        const auto handle = static_cast<LabelHandle>(size());
+        const std::wstring wide = Utf8ToWstring(utf8);
+        mArena.append(wide.begin(), wide.end());
+        mOffsets.push_back(static_cast<uint32_t>(mArena.size()));
+        mLookup.emplace(utf8, handle);
+        return handle;
+    }
+
+    LabelHandle LabelTable::internWide(std::wstring_view text) {
+        if (text.empty()) {
+            return EMPTY_LABEL;
+        }
+        if (mWideLookup.empty()) {
+            for (LabelHandle handle = EMPTY_LABEL + 1; handle < size(); ++handle) {
+                mWideLookup.emplace(std::wstring(get(handle)), handle);
+            }
+        }
+        std::wstring key(text);
+        auto it = mWideLookup.find(key);
+        if (it != mWideLookup.end()) {
+            return it->second;
+        }
+        const auto handle = static_cast<LabelHandle>(size());
+        mArena.append(text.begin(), text.end());
+        mOffsets.push_back(static_cast<uint32_t>(mArena.size()));
+        mWideLookup.emplace(std::move(key), handle);
+        return handle;
+    }
+
+    void LabelTable::finalize() {
+        mLookup = {};
+        mWideLookup = {};
+        mArena.shrinkToFit();
+        mOffsets.shrinkToFit();
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_LABEL_TABLE_H
+#define RENDERPLUGIN_LABEL_TABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "column.h"
+
+namespace RenderPlugin {
+    /** 文字标签句柄，见 LabelTable */
+    using LabelHandle = uint32_t;
+
+    /**
+     * 文字标签字符串表：所有标签以宽字符（Windows 下即 UTF-16）连续存放在同一块内存中，
+     * 要素只保存 32 位句柄。加载时按 UTF-8 原文去重，相同的标签只转换和存储一次。
+     * 句柄 0 固定为空字符串；句柄在数据集生命周期内不变，可作为文字缓存的键。
+     */
+    class LabelTable {
+    public:
+        static constexpr LabelHandle EMPTY_LABEL = 0;
+
+        LabelTable();
+
+        /** 返回 UTF-8 标签的句柄，首次出现时转换为宽字符并追加到字符串区 */
+        LabelHandle intern(std::string_view utf8);
+
+        /** 返回宽字符标签的句柄，不做编码转换；用于在字符串表之间复制标签 */
+        LabelHandle internWide(std::wstring_view text);
+
+        [[nodiscard]] std::wstring_view get(LabelHandle handle) const {
+            return {mArena.data() + mOffsets[handle], mOffsets[handle + 1] - mOffsets[handle]};
+        }
+
+        /** 不同标签的数量（含空字符串） */
+        [[nodiscard]] size_t size() const { return mOffsets.size() - 1; }
+
+        /** 字符串区占用的宽字符数 */
+        [[nodiscard]] size_t arenaSize() const { return mArena.size(); }
+
+        /** 加载结束后调用，释放去重用的查找表 */
+        void finalize();
+
+    private:
+        struct TransparentHash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+        };
+
+        friend class FeatureStoreBinary;
+
+        Column<wchar_t> mArena;
+        // 第 i 个标签占用 [mOffsets[i], mOffsets[i + 1])
+        Column<uint32_t> mOffsets;
+        std::unordered_map<std::string, LabelHandle, TransparentHash, std::equal_to<>> mLookup;
+        std::unordered_map<std::wstring, LabelHandle> mWideLookup; // 仅 internWide 使用，首次使用时建立
+    };
+}
+
+#endif
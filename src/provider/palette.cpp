@@ -0,0 +1,34 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+
+#include "palette.h"
+
+namespace {
+    std::atomic<uint64_t> nextPaletteId{1};
+}
+
+namespace RenderPlugin {
+    Palette::Palette() : mId(nextPaletteId.fetch_add(1, std::memory_order_relaxed)) {
+        intern(Color());
+    }
+
+    void Palette::renewId() {
+        mId = nextPaletteId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PaletteIndex Palette::intern(const Color &color) {
+        auto it = mLookup.find(color);
+        if (it != mLookup.end()) {
+            return it->second;
+        }
+        if (mColors.size() >= MAX_SIZE) {
+            return DEFAULT_INDEX;
+        }
+        const auto index = static_cast<PaletteIndex>(mColors.size());
+        mColors.push_back(color);
+        mLookup.emplace(color, index);
+        return index;
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_PALETTE_H
+#define RENDERPLUGIN_PALETTE_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "render_data_definition.hpp"
+
+namespace RenderPlugin {
+    /**
+     * 数据集调色板：加载时把所有用到的颜色去重后放入调色板，要素只保存 16 位下标。
+     * 下标 0 固定为默认颜色（不透明黑色），未配置或无法解析的颜色均指向它。
+     * 各渲染后端根据调色板建立自己的颜色表和画刷缓存，通过 id() 判断调色板是否已变化。
+     */
+    class Palette {
+    public:
+        static constexpr PaletteIndex DEFAULT_INDEX = 0;
+        static constexpr size_t MAX_SIZE = 65536;
+
+        Palette();
+
+        /** 返回颜色在调色板中的下标，不存在时追加；调色板已满时返回默认颜色下标 */
+        PaletteIndex intern(const Color &color);
+
+        [[nodiscard]] const Color &operator[](PaletteIndex index) const { return mColors[index]; }
+
+        [[nodiscard]] const std::vector<Color> &colors() const { return mColors; }
+
+        [[nodiscard]] size_t size() const { return mColors.size(); }
+
+        /** 调色板实例的唯一标识，每次构造时分配，复制时保留 */
+        [[nodiscard]] uint64_t id() const { return mId; }
+
+        /** 分配新的标识；在复制得到的调色板上追加颜色后调用，使后端重建颜色表 */
+        void renewId();
+
+    private:
+        uint64_t mId;
+        std::vector<Color> mColors;
+        std::map<Color, PaletteIndex> mLookup;
+    };
+}
+
+#endif
@@ -4,15 +4,14 @@
 #ifndef RENDERPLUGIN_RENDER_DATA_DEFINE_H
 #define RENDERPLUGIN_RENDER_DATA_DEFINE_H
 
+#include <algorithm>
 #include <cctype>
-#include <d2d1.h>
-#include <gdiplus.h>
+#include <cmath>
+#include <compare>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
-#include <windows.h>
-
-#include "EuroScopePlugIn.h"
 
 namespace RenderPlugin {
     struct Color {
@@ -22,17 +21,15 @@ namespace RenderPlugin {
         uchar green;
         uchar blue;
         uchar alpha;
-        Gdiplus::Color gdiColor{};
-        D2D1_COLOR_F d2dColor{};
 
         Color() noexcept: Color(0, 0, 0) {}
 
         Color(uchar red, uchar green, uchar blue) noexcept: Color(red, green, blue, 255) {}
 
         Color(uchar red, uchar green, uchar blue, uchar alpha) noexcept
-                : red(red), green(green), blue(blue), alpha(alpha) {
-            updateDerivedColors();
-        }
+                : red(red), green(green), blue(blue), alpha(alpha) {}
+
+        auto operator<=>(const Color &) const = default;
 
         static Color fromColorString(const std::string &color) {
             if (color.empty() || color[0] != '#') {
@@ -62,11 +59,6 @@ namespace RenderPlugin {
             }
         }
 
-        void updateDerivedColors() {
-            gdiColor = Gdiplus::Color(alpha, red, green, blue);
-            d2dColor = D2D1::ColorF(red / 255.0f, green / 255.0f, blue / 255.0f, alpha / 255.0f);
-        }
-
     private:
         static std::string expandShortHex(const std::string &shortHex, bool hasAlpha) {
             std::string expanded;
@@ -81,6 +73,9 @@ namespace RenderPlugin {
         }
     };
 
+    /** 调色板下标，见 Palette */
+    using PaletteIndex = uint16_t;
+
     struct Coordinate {
         double mLongitude{};
         double mLatitude{};
@@ -88,18 +83,63 @@ namespace RenderPlugin {
         Coordinate() = default;
 
         Coordinate(double longitude, double latitude) : mLongitude(longitude), mLatitude(latitude) {}
+    };
+
+    using Coordinates = std::vector<Coordinate>;
 
-        [[nodiscard]] EuroScopePlugIn::CPosition toPosition() const {
-            EuroScopePlugIn::CPosition pos;
-            pos.m_Latitude = mLatitude;
-            pos.m_Longitude = mLongitude;
-            return pos;
+    /** 量化坐标：经纬度以 1e-7 度为单位存为 int32，每个顶点 8 字节（Coordinate 为 16 字节） */
+    struct QuantizedCoordinate {
+        static constexpr double SCALE = 1e7;
+        static constexpr double INV_SCALE = 1e-7;
+
+        int32_t mLongitude{};
+        int32_t mLatitude{};
+
+        QuantizedCoordinate() = default;
+
+        explicit QuantizedCoordinate(const Coordinate &coord)
+                : mLongitude(quantize(coord.mLongitude)), mLatitude(quantize(coord.mLatitude)) {}
+
+        [[nodiscard]] double longitude() const { return mLongitude * INV_SCALE; }
+
+        [[nodiscard]] double latitude() const { return mLatitude * INV_SCALE; }
+
+        [[nodiscard]] Coordinate toCoordinate() const { return {longitude(), latitude()}; }
+
+    private:
+        static int32_t quantize(double degrees) {
+            // 经度 ±180 度量化后为 ±1.8e9，在 int32 范围内；超出范围的非法值截断
+            const double scaled = std::round(degrees * SCALE);
+            return static_cast<int32_t>(std::clamp(scaled, -2147483647.0, 2147483647.0));
         }
     };
 
-    using Coordinates = std::vector<Coordinate>;
+    /** 坐标池的存储方式 */
+    enum class CoordinateStorage : uint8_t {
+        Double,     // 双精度浮点，16 字节 / 顶点
+        Quantized   // int32 量化（约 1e-7 度，赤道处约 1 厘米），8 字节 / 顶点
+    };
+
+    constexpr auto COORDINATE_STORAGE_DOUBLE = "double";
+    constexpr auto COORDINATE_STORAGE_QUANTIZED = "quantized";
+
+    inline std::string coordinateStorageToString(CoordinateStorage storage) {
+        return storage == CoordinateStorage::Quantized ? COORDINATE_STORAGE_QUANTIZED : COORDINATE_STORAGE_DOUBLE;
+    }
 
-    enum class RenderType {
+    inline CoordinateStorage stringToCoordinateStorage(const std::string &str) {
+        std::string lower;
+        lower.reserve(str.size());
+        for (unsigned char c : str) {
+            lower.push_back(static_cast<char>(std::tolower(c)));
+        }
+        if (lower == COORDINATE_STORAGE_QUANTIZED) {
+            return CoordinateStorage::Quantized;
+        }
+        return CoordinateStorage::Double;
+    }
+
+    enum class RenderType : uint8_t {
         LINE,
         AREA,
         TEXT
@@ -132,7 +172,7 @@ namespace RenderPlugin {
         return RenderType::AREA;
     }
 
-    enum class LineStyle {
+    enum class LineStyle : uint8_t {
         Solid,
         Dashed
     };
@@ -158,7 +198,7 @@ namespace RenderPlugin {
     }
 
     // 文字控制点：左上、上中、右上、左中、中、右中、左下、下中、右下
-    enum class TextAnchor {
+    enum class TextAnchor : uint8_t {
         TopLeft,
         TopCenter,
         TopRight,
@@ -213,22 +253,28 @@ namespace RenderPlugin {
         return TextAnchor::TopLeft;
     }
 
+    /** 要素在缩放等级 zoom 下是否绘制：不小于最小缩放等级，且最大缩放等级为 0（不限）或不大于最大缩放等级 */
+    constexpr bool isZoomVisible(int zoom, int minZoom, int maxZoom) {
+        return zoom >= minZoom && (maxZoom == 0 || zoom <= maxZoom);
+    }
+
     struct RenderData {
         RenderType mType{RenderType::AREA};
         Coordinates mCoordinates{};
         std::string mRawFill{}; // color which will be filled in the area, only used in area type
-        Color mFill{};
+        PaletteIndex mFill{}; // resolved palette index of fill
         std::string mRawColor{}; // line color or text color
-        Color mColor{};
-        std::wstring mText{}; // text content, supports multi-line with \n
+        PaletteIndex mColor{}; // resolved palette index of color
+        std::string mText{}; // UTF-8 text content, supports multi-line with \n; interned into the label table on load
         int mFontSize{}; // text font size
         TextAnchor mTextAnchor{TextAnchor::TopLeft}; // 控制点: topLeft|topCenter|topRight|midLeft|center|midRight|bottomLeft|bottomCenter|bottomRight
         std::string mRawTextBackground{}; // text background color (name or #RRGGBB), empty = no background
-        Color mTextBackground{}; // resolved text background color
+        PaletteIndex mTextBackground{}; // resolved text background palette index
         std::string mRawTextBackgroundStroke{}; // text background box border color, empty = no stroke
-        Color mTextBackgroundStroke{}; // resolved text background stroke color
+        PaletteIndex mTextBackgroundStroke{}; // resolved text background stroke palette index
         float mTextBackgroundStrokeWidth{2.0f}; // text background box border width (px), default 2
         int mZoom{}; // zoom level 1-19, 当前 zoom 小于此值时不绘制；0 表示任意等级都绘制
+        int mMaxZoom{}; // zoom level 1-19, 当前 zoom 大于此值时不绘制；0 表示不限
         LineStyle mLineStyle{LineStyle::Solid}; // line style for LINE type (solid / dashed)
         float mStrokeWidth{0.0f};   // line/outline width, 0 = use default (1.0 solid, 2.0 dashed)
         float mDashLength{0.0f};   // dashed: dash segment length, 0 = use default (10.0)
@@ -253,16 +299,22 @@ namespace RenderPlugin {
                                                     mTextBackgroundStroke(instance.mTextBackgroundStroke),
                                                     mTextBackgroundStrokeWidth(instance.mTextBackgroundStrokeWidth),
                                                     mZoom(instance.mZoom),
+                                                    mMaxZoom(instance.mMaxZoom),
                                                     mLineStyle(instance.mLineStyle),
                                                     mStrokeWidth(instance.mStrokeWidth),
                                                     mDashLength(instance.mDashLength),
                                                     mGapLength(instance.mGapLength) {};
+
+        RenderData &operator=(const RenderData &instance) = default;
+
+        RenderData &operator=(RenderData &&instance) noexcept = default;
     };
 
     using ColorMap = std::map<std::string, Color>;
     using RenderDataVector = std::vector<RenderData>;
     constexpr auto COLOR_KEY = "color";
     constexpr auto FEATURE_KEY = "features";
+    constexpr auto INCLUDE_KEY = "include";
 }
 
 #endif
@@ -0,0 +1,203 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "render_data_field_decoder.h"
+
+namespace {
+    using RenderPlugin::FeatureField;
+
+    struct FieldEntry {
+        std::string_view mKey;
+        FeatureField mField;
+    };
+
+    // sorted by key, checked below
+    constexpr std::array FIELD_TABLE{
+            FieldEntry{"color", FeatureField::Color},
+            FieldEntry{"coordinates", FeatureField::Coordinates},
+            FieldEntry{"dash", FeatureField::Dash},
+            FieldEntry{"dashLength", FeatureField::DashLength},
+            FieldEntry{"fill", FeatureField::Fill},
+            FieldEntry{"gapLength", FeatureField::GapLength},
+            FieldEntry{"lineStyle", FeatureField::LineStyle},
+            FieldEntry{"maxZoom", FeatureField::MaxZoom},
+            FieldEntry{"size", FeatureField::Size},
+            FieldEntry{"stroke", FeatureField::Stroke},
+            FieldEntry{"strokeWidth", FeatureField::StrokeWidth},
+            FieldEntry{"text", FeatureField::Text},
+            FieldEntry{"textAnchor", FeatureField::TextAnchor},
+            FieldEntry{"textBackground", FeatureField::TextBackground},
+            FieldEntry{"textBackgroundStroke", FeatureField::TextBackgroundStroke},
+            FieldEntry{"textBackgroundStrokeWidth", FeatureField::TextBackgroundStrokeWidth},
+            FieldEntry{"type", FeatureField::Type},
+            FieldEntry{"zoom", FeatureField::Zoom},
+    };
+
+    constexpr bool isSorted() {
+        for (size_t i = 1; i < FIELD_TABLE.size(); ++i) {
+            if (!(FIELD_TABLE[i - 1].mKey < FIELD_TABLE[i].mKey)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(isSorted(), "FIELD_TABLE must be sorted by key");
+    static_assert(FIELD_TABLE.size() == static_cast<size_t>(FeatureField::Unknown), "every field needs a key");
+}
+
+namespace RenderPlugin {
+    FeatureField lookupFeatureField(std::string_view key) {
+        const auto it = std::lower_bound(FIELD_TABLE.begin(), FIELD_TABLE.end(), key,
+                                         [](const FieldEntry &entry, std::string_view k) { return entry.mKey < k; });
+        return it != FIELD_TABLE.end() && it->mKey == key ? it->mField : FeatureField::Unknown;
+    }
+
+    FeatureFieldDecoder::FeatureFieldDecoder(std::vector<DecodeError> &errors) : mErrors(&errors) {}
+
+    void FeatureFieldDecoder::begin() {
+        mFeature = RenderData();
+        mHasType = false;
+        mHasStroke = false;
+        mHasDashKey = false;
+        mDashLength = 0.0f;
+        mGapLength = 0.0f;
+    }
+
+    void FeatureFieldDecoder::setScalar(FeatureField field, std::string_view key, const std::string &value,
+                                        size_t line) {
+        switch (field) {
+            case FeatureField::Type:
+                mFeature.mType = stringToRenderType(value);
+                mHasType = true;
+                break;
+            case FeatureField::Fill:
+                mFeature.mRawFill = value;
+                break;
+            case FeatureField::Color:
+                mFeature.mRawColor = value;
+                break;
+            case FeatureField::Text:
+                mFeature.mText = value;
+                break;
+            case FeatureField::Size:
+                parseNumber(key, value, line, mFeature.mFontSize);
+                break;
+            case FeatureField::TextAnchor:
+                mFeature.mTextAnchor = stringToTextAnchor(value);
+                break;
+            case FeatureField::TextBackground:
+                mFeature.mRawTextBackground = value;
+                break;
+            case FeatureField::TextBackgroundStroke:
+                mFeature.mRawTextBackgroundStroke = value;
+                break;
+            case FeatureField::TextBackgroundStrokeWidth:
+                parseNumber(key, value, line, mFeature.mTextBackgroundStrokeWidth);
+                break;
+            case FeatureField::Zoom:
+                parseNumber(key, value, line, mFeature.mZoom);
+                break;
+            case FeatureField::MaxZoom:
+                parseNumber(key, value, line, mFeature.mMaxZoom);
+                break;
+            case FeatureField::Stroke:
+                mFeature.mLineStyle = stringToLineStyle(value);
+                mHasStroke = true;
+                break;
+            case FeatureField::LineStyle:
+                if (!mHasStroke) {
+                    mFeature.mLineStyle = stringToLineStyle(value);
+                }
+                break;
+            case FeatureField::StrokeWidth:
+                parseNumber(key, value, line, mFeature.mStrokeWidth);
+                break;
+            case FeatureField::Dash:
+                // a scalar dash is not a [dash, gap] pair, it still disables dashLength / gapLength
+                mHasDashKey = true;
+                break;
+            case FeatureField::DashLength:
+                parseNumber(key, value, line, mDashLength);
+                break;
+            case FeatureField::GapLength:
+                parseNumber(key, value, line, mGapLength);
+                break;
+            case FeatureField::Coordinates:
+                error(line, "'coordinates' must be a list of [longitude, latitude] pairs");
+                break;
+            case FeatureField::Unknown:
+                break;
+        }
+    }
+
+    void FeatureFieldDecoder::setDash(const std::vector<double> &numbers) {
+        mHasDashKey = true;
+        if (numbers.size() >= 2) {
+            mFeature.mDashLength = static_cast<float>(numbers[0]);
+            mFeature.mGapLength = static_cast<float>(numbers[1]);
+        }
+    }
+
+    void FeatureFieldDecoder::addCoordinate(const std::vector<double> &numbers, size_t line) {
+        if (numbers.size() != 2) {
+            error(line, "coordinate must be a [longitude, latitude] pair, dropped");
+            return;
+        }
+        mFeature.mCoordinates.emplace_back(numbers[0], numbers[1]);
+    }
+
+    bool FeatureFieldDecoder::finish(size_t line, RenderData &data) {
+        if (!mHasType) {
+            error(line, "feature is missing 'type', skipped");
+            return false;
+        }
+        if (!mHasDashKey) {
+            mFeature.mDashLength = mDashLength;
+            mFeature.mGapLength = mGapLength;
+        }
+        data = std::move(mFeature);
+        mFeature = RenderData();
+        return true;
+    }
+
+    void FeatureFieldDecoder::error(size_t line, std::string message) {
+        mErrors->push_back({line, std::move(message)});
+    }
+
+    template<typename T>
+    bool FeatureFieldDecoder::parseNumber(std::string_view key, std::string_view value, size_t line, T &result) {
+        const char *first = value.data();
+        const char *last = first + value.size();
+        if (first != last && *first == '+') {
+            ++first;
+        }
+        T parsed{};
+        auto [ptr, ec] = std::from_chars(first, last, parsed);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (ec == std::errc() && !std::isfinite(parsed)) {
+                ec = std::errc::invalid_argument;
+            }
+        }
+        if (ec != std::errc() || ptr != last || first == last) {
+            error(line, "invalid number for '" + std::string(key) + "': " + std::string(value));
+            return false;
+        }
+        result = parsed;
+        return true;
+    }
+
+    template bool FeatureFieldDecoder::parseNumber<int>(std::string_view, std::string_view, size_t, int &);
+
+    template bool FeatureFieldDecoder::parseNumber<float>(std::string_view, std::string_view, size_t, float &);
+
+    template bool FeatureFieldDecoder::parseNumber<double>(std::string_view, std::string_view, size_t, double &);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_FIELD_DECODER_H
+#define RENDERPLUGIN_RENDER_DATA_FIELD_DECODER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "render_data_definition.hpp"
+
+namespace RenderPlugin {
+    /** 要素的字段，与 YAML 要素的键一一对应 */
+    enum class FeatureField : uint8_t {
+        Type,
+        Coordinates,
+        Fill,
+        Color,
+        Text,
+        Size,
+        TextAnchor,
+        TextBackground,
+        TextBackgroundStroke,
+        TextBackgroundStrokeWidth,
+        Zoom,
+        MaxZoom,
+        Stroke,
+        LineStyle,
+        StrokeWidth,
+        Dash,
+        DashLength,
+        GapLength,
+        Unknown     // 不认识的键，忽略
+    };
+
+    /** 在编译期按键名排序的表中二分查找，不分配内存 */
+    FeatureField lookupFeatureField(std::string_view key);
+
+    /** 加载时发现的数据错误：出错的字段被忽略或要素被跳过，加载继续 */
+    struct DecodeError {
+        size_t mLine;           // 从 1 开始的行号，0 表示未知
+        std::string mMessage;
+        std::string mFile{};    // include 的文件路径，主数据文件中的错误为空
+    };
+
+    /**
+     * 单个要素的字段解码器，由 DOM 和流式两种解码方式共用，保证字段语义一致：
+     * stroke 优先于 lineStyle，出现 dash 键时忽略 dashLength / gapLength。
+     * 数值无效时记录错误并保留缺省值，坐标无效时丢弃该坐标，缺少 type 时跳过整个要素，均不抛出异常
+     */
+    class FeatureFieldDecoder {
+    public:
+        explicit FeatureFieldDecoder(std::vector<DecodeError> &errors);
+
+        void begin();
+
+        [[nodiscard]] RenderData &feature() { return mFeature; }
+
+        /** 标量字段，键名只用于错误信息 */
+        void setScalar(FeatureField field, std::string_view key, const std::string &value, size_t line);
+
+        /** dash 键：numbers 至少两个元素时生效，否则只屏蔽 dashLength / gapLength */
+        void setDash(const std::vector<double> &numbers);
+
+        /** 追加一个 [经度, 纬度] 坐标，数值个数不为 2 时记录错误并丢弃 */
+        void addCoordinate(const std::vector<double> &numbers, size_t line);
+
+        /** 结束要素并移出到 data；要素须跳过时记录错误并返回 false */
+        bool finish(size_t line, RenderData &data);
+
+        void error(size_t line, std::string message);
+
+        /** 解析数值，整个字符串须为数值（允许前导 +）；失败时记录错误并返回 false */
+        template<typename T>
+        bool parseNumber(std::string_view key, std::string_view value, size_t line, T &result);
+
+    private:
+        std::vector<DecodeError> *mErrors;
+        RenderData mFeature;
+        bool mHasType{false};
+        bool mHasStroke{false};
+        bool mHasDashKey{false};
+        float mDashLength{0.0f};   // dashLength / gapLength 在要素结束时才确定是否生效
+        float mGapLength{0.0f};
+    };
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <cctype>
+
+#include "render_data_geojson_provider.h"
+#include "render_data_geojson_stream.h"
+
+namespace RenderPlugin {
+    bool isGeoJsonPath(const fs::path &path) {
+        std::string extension = path.extension().string();
+        for (char &c: extension) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return extension == GEOJSON_EXTENSION || extension == JSON_EXTENSION;
+    }
+
+    RenderDataGeoJsonProvider::RenderDataGeoJsonProvider() : RenderDataProvider() {}
+
+    bool RenderDataGeoJsonProvider::loadData(const fs::path &path) {
+        if (mIsLoaded) {
+            return false;
+        }
+        return loadSourceFile(path, [this](std::string_view text) { return loadText(text); });
+    }
+
+    bool RenderDataGeoJsonProvider::loadText(std::string_view text) {
+        mColorMap = std::make_shared<ColorMap>();
+        mPalette = Palette();
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+
+        // features are resolved and appended as soon as they are read, GIS exports have no color table at all
+        bool hasFeature = false;
+        bool colorsAfterFeatures = false;
+        auto appendFeature = [this, &store, &hasFeature](RenderData &&data) {
+            hasFeature = true;
+            resolveColors(data);
+            store->append(std::move(data));
+        };
+        RenderDataGeoJsonReader reader({
+                [this](const std::string &name, const std::string &value) { addColor(name, value); },
+                [&]() { colorsAfterFeatures = hasFeature; },
+                appendFeature
+        });
+        mLoadErrors.clear();
+        reader.read(text);
+        mLoadErrors = reader.errors();
+        if (!reader.hasFeatures()) {
+            mColorMap.reset();
+            mPalette = Palette();
+            return false;
+        }
+        if (colorsAfterFeatures) {
+            // the color table follows the features, so read them again now that the names are known
+            mPalette = Palette();
+            store = std::make_shared<FeatureStore>(mCoordinateStorage);
+            RenderDataGeoJsonReader featureReader({nullptr, nullptr, appendFeature});
+            featureReader.read(text);
+            mLoadErrors = featureReader.errors();
+        }
+
+        store->setPalette(std::move(mPalette));
+        store->finalize();
+        mPalette = Palette();
+        mFeatureStore = std::move(store);
+        return true;
+    }
+}
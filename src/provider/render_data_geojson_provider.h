@@ -0,0 +1,34 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_GEOJSON_PROVIDER_H
+#define RENDERPLUGIN_RENDER_DATA_GEOJSON_PROVIDER_H
+
+#include <string_view>
+
+#include "render_data_provider.h"
+
+namespace RenderPlugin {
+    constexpr auto GEOJSON_EXTENSION = ".geojson";
+    constexpr auto JSON_EXTENSION = ".json";
+
+    /** 按扩展名（.geojson / .json，不区分大小写）判断数据文件是否为 GeoJSON */
+    bool isGeoJsonPath(const fs::path &path);
+
+    /**
+     * GeoJSON 数据集（FeatureCollection），用事件式解析器直接在映射的文件内容上解析，不构建文档树。
+     * 几何与 properties 的映射见 RenderDataGeoJsonReader。要素解析完即写入存储；
+     * 可选的顶层 color 成员（颜色表）写在 features 之后时，整个文件按已知的颜色表再解析一遍
+     */
+    class RenderDataGeoJsonProvider : public RenderDataProvider {
+    public:
+        RenderDataGeoJsonProvider();
+
+        virtual bool loadData(const fs::path &path) override;
+
+    private:
+        bool loadText(std::string_view text);
+    };
+}
+
+#endif
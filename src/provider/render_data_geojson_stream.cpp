@@ -0,0 +1,448 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <charconv>
+#include <cmath>
+#include <system_error>
+#include <utility>
+
+#include "render_data_geojson_stream.h"
+
+namespace {
+    constexpr auto FEATURE_COLLECTION = "FeatureCollection";
+    constexpr auto GEOMETRY_KEY = "geometry";
+    constexpr auto PROPERTIES_KEY = "properties";
+    constexpr auto COORDINATES_KEY = "coordinates";
+    constexpr auto TYPE_KEY = "type";
+
+    // nesting level of the coordinates array of each geometry type
+    constexpr int POSITION_LEVEL = 1;
+    constexpr int LINE_LEVEL = 2;
+    constexpr int POLYGON_LEVEL = 3;
+    constexpr int MULTI_POLYGON_LEVEL = 4;
+}
+
+namespace RenderPlugin {
+    RenderDataGeoJsonReader::RenderDataGeoJsonReader(Callbacks callbacks) : mCallbacks(std::move(callbacks)) {}
+
+    void RenderDataGeoJsonReader::read(std::string_view text) {
+        JsonSaxParser parser(text);
+        mParser = &parser;
+        mStack.clear();
+        mSkipDepth = 0;
+        mErrors.clear();
+        try {
+            parser.parse(*this);
+        } catch (...) {
+            mParser = nullptr;
+            throw;
+        }
+        mParser = nullptr;
+    }
+
+    void RenderDataGeoJsonReader::onObjectStart() {
+        beginContainer(true);
+    }
+
+    void RenderDataGeoJsonReader::onArrayStart() {
+        beginContainer(false);
+    }
+
+    void RenderDataGeoJsonReader::onObjectEnd() {
+        onArrayEnd();
+    }
+
+    void RenderDataGeoJsonReader::onArrayEnd() {
+        if (mSkipDepth > 0) {
+            --mSkipDepth;
+            return;
+        }
+        const Frame frame = mStack.back();
+        mStack.pop_back();
+        switch (frame.mKind) {
+            case FrameKind::ColorMap:
+                if (mCallbacks.onColorsEnd) {
+                    mCallbacks.onColorsEnd();
+                }
+                break;
+            case FrameKind::Feature:
+                endFeature();
+                break;
+            case FrameKind::CoordinateArray: {
+                int level = -1;
+                if (frame.mChildLevel == 0) {
+                    // extra values (altitude) are ignored
+                    if (mInvalidPosition) {
+                        error("position has a value that is not a finite number, dropped");
+                    } else if (mNumbers.size() < 2) {
+                        error("position must have a longitude and a latitude, dropped");
+                    } else {
+                        mPositions.emplace_back(mNumbers[0], mNumbers[1]);
+                    }
+                    mNumbers.clear();
+                    mInvalidPosition = false;
+                    level = POSITION_LEVEL;
+                } else if (frame.mChildLevel > 0) {
+                    level = frame.mChildLevel + 1;
+                    if (level == LINE_LEVEL) {
+                        mLineEnds.push_back(mPositions.size());
+                    } else if (level == POLYGON_LEVEL) {
+                        mPolygonEnds.push_back(mLineEnds.size());
+                    } else if (level > MULTI_POLYGON_LEVEL) {
+                        throw mParser->error("coordinates are nested too deeply");
+                    }
+                }
+                if (mStack.back().mKind != FrameKind::CoordinateArray) {
+                    mCoordinateLevel = level;
+                } else if (level > 0) {
+                    // empty arrays do not tell their level and are left out
+                    Frame &parent = mStack.back();
+                    if (parent.mChildLevel >= 0 && parent.mChildLevel != level) {
+                        throw mParser->error("inconsistent coordinate nesting");
+                    }
+                    parent.mChildLevel = level;
+                }
+                break;
+            }
+            case FrameKind::DashArray:
+                if (mNumbers.size() >= 2) {
+                    mFeature.mDashLength = static_cast<float>(mNumbers[0]);
+                    mFeature.mGapLength = static_cast<float>(mNumbers[1]);
+                }
+                mNumbers.clear();
+                break;
+            case FrameKind::Root:
+            case FrameKind::FeatureArray:
+            case FrameKind::Geometry:
+            case FrameKind::Properties:
+                break;
+        }
+    }
+
+    void RenderDataGeoJsonReader::onKey(std::string_view key) {
+        if (mSkipDepth == 0) {
+            mKey.assign(key);
+        }
+    }
+
+    void RenderDataGeoJsonReader::onString(std::string_view value) {
+        scalar(value, true);
+    }
+
+    void RenderDataGeoJsonReader::onNumber(std::string_view text) {
+        scalar(text, false);
+    }
+
+    void RenderDataGeoJsonReader::onBool(bool) {
+        if (mSkipDepth == 0 && !mStack.empty() && mStack.back().mKind == FrameKind::CoordinateArray) {
+            addCoordinateValue(mStack.back(), nullptr);
+        }
+    }
+
+    void RenderDataGeoJsonReader::onNull() {
+        onBool(false);
+    }
+
+    void RenderDataGeoJsonReader::scalar(std::string_view value, bool isString) {
+        if (mSkipDepth > 0) {
+            return;
+        }
+        if (mStack.empty()) {
+            throw mParser->error("root must be a FeatureCollection object");
+        }
+        Frame &frame = mStack.back();
+        switch (frame.mKind) {
+            case FrameKind::Root:
+                if (mKey == TYPE_KEY && value != FEATURE_COLLECTION) {
+                    throw mParser->error("root must be a FeatureCollection, got '" + std::string(value) + "'");
+                }
+                break;
+            case FrameKind::ColorMap:
+                if (isString && mCallbacks.onColor) {
+                    mCallbacks.onColor(mKey, std::string(value));
+                }
+                break;
+            case FrameKind::FeatureArray:
+                throw mParser->error("feature must be an object");
+            case FrameKind::Geometry:
+                if (mKey == TYPE_KEY) {
+                    mGeometryType.assign(value);
+                }
+                break;
+            case FrameKind::Properties:
+                setProperty(mKey, value);
+                break;
+            case FrameKind::CoordinateArray: {
+                double number = 0.0;
+                addCoordinateValue(frame, !isString && parseNumber(value, number) ? &number : nullptr);
+                break;
+            }
+            case FrameKind::DashArray: {
+                double number = 0.0;
+                if (parseNumber(value, number)) {
+                    mNumbers.push_back(number);
+                }
+                break;
+            }
+            case FrameKind::Feature:
+                break;
+        }
+    }
+
+    void RenderDataGeoJsonReader::beginContainer(bool isObject) {
+        if (mSkipDepth > 0) {
+            ++mSkipDepth;
+            return;
+        }
+        if (mStack.empty()) {
+            if (!isObject) {
+                throw mParser->error("root must be a FeatureCollection object");
+            }
+            mStack.push_back({FrameKind::Root});
+            return;
+        }
+        Frame &frame = mStack.back();
+        switch (frame.mKind) {
+            case FrameKind::Root:
+                if (isObject && mKey == COLOR_KEY) {
+                    mHasColors = true;
+                    mStack.push_back({FrameKind::ColorMap});
+                    return;
+                }
+                if (!isObject && mKey == FEATURE_KEY) {
+                    mHasFeatures = true;
+                    mStack.push_back({FrameKind::FeatureArray});
+                    return;
+                }
+                break;
+            case FrameKind::FeatureArray:
+                if (!isObject) {
+                    throw mParser->error("feature must be an object");
+                }
+                beginFeature();
+                mStack.push_back({FrameKind::Feature});
+                return;
+            case FrameKind::Feature:
+                if (isObject && mKey == GEOMETRY_KEY) {
+                    mStack.push_back({FrameKind::Geometry});
+                    return;
+                }
+                if (isObject && mKey == PROPERTIES_KEY) {
+                    mStack.push_back({FrameKind::Properties});
+                    return;
+                }
+                break;
+            case FrameKind::Geometry:
+                if (!isObject && mKey == COORDINATES_KEY) {
+                    mPositions.clear();
+                    mLineEnds.clear();
+                    mPolygonEnds.clear();
+                    mNumbers.clear();
+                    mInvalidPosition = false;
+                    mStack.push_back({FrameKind::CoordinateArray});
+                    return;
+                }
+                break;
+            case FrameKind::Properties:
+                if (!isObject && mKey == "dash") {
+                    mHasDashKey = true;
+                    mNumbers.clear();
+                    mStack.push_back({FrameKind::DashArray});
+                    return;
+                }
+                break;
+            case FrameKind::CoordinateArray:
+                if (isObject) {
+                    throw mParser->error("coordinate must be a number array");
+                }
+                if (frame.mChildLevel == 0) {
+                    throw mParser->error("inconsistent coordinate nesting");
+                }
+                mStack.push_back({FrameKind::CoordinateArray});
+                return;
+            case FrameKind::ColorMap:
+            case FrameKind::DashArray:
+                break;
+        }
+        // bbox, foreign members, nested property values and other parts we do not use
+        mSkipDepth = 1;
+    }
+
+    void RenderDataGeoJsonReader::beginFeature() {
+        mFeature = RenderData();
+        mName.clear();
+        mHasStroke = false;
+        mHasDashKey = false;
+        mDashLength = 0.0f;
+        mGapLength = 0.0f;
+        mGeometryType.clear();
+        mCoordinateLevel = -1;
+        mPositions.clear();
+        mLineEnds.clear();
+        mPolygonEnds.clear();
+    }
+
+    void RenderDataGeoJsonReader::endFeature() {
+        // 与 YAML 解码一致：出现 dash 键时忽略 dashLength / gapLength
+        if (!mHasDashKey) {
+            mFeature.mDashLength = mDashLength;
+            mFeature.mGapLength = mGapLength;
+        }
+        if (mCoordinateLevel < 0) {
+            // null geometry or empty coordinates
+            ++mSkippedFeatures;
+            return;
+        }
+
+        // every part becomes a feature of its own: [begin, end) ranges of mPositions
+        auto lineBegin = [this](size_t line) { return line == 0 ? 0 : mLineEnds[line - 1]; };
+        std::vector<std::pair<size_t, size_t>> parts;
+        RenderType type;
+        int expectedLevel;
+        if (mGeometryType == "Point" || mGeometryType == "MultiPoint") {
+            type = RenderType::TEXT;
+            expectedLevel = mGeometryType == "Point" ? POSITION_LEVEL : LINE_LEVEL;
+            for (size_t i = 0; i < mPositions.size(); ++i) {
+                parts.emplace_back(i, i + 1);
+            }
+        } else if (mGeometryType == "LineString" || mGeometryType == "MultiLineString") {
+            type = RenderType::LINE;
+            expectedLevel = mGeometryType == "LineString" ? LINE_LEVEL : POLYGON_LEVEL;
+            for (size_t line = 0; line < mLineEnds.size(); ++line) {
+                parts.emplace_back(lineBegin(line), mLineEnds[line]);
+            }
+        } else if (mGeometryType == "Polygon" || mGeometryType == "MultiPolygon") {
+            // holes cannot be drawn, only the outer ring of each polygon is kept
+            type = RenderType::AREA;
+            expectedLevel = mGeometryType == "Polygon" ? POLYGON_LEVEL : MULTI_POLYGON_LEVEL;
+            for (size_t polygon = 0; polygon < mPolygonEnds.size(); ++polygon) {
+                const size_t firstLine = polygon == 0 ? 0 : mPolygonEnds[polygon - 1];
+                if (firstLine < mPolygonEnds[polygon]) {
+                    parts.emplace_back(lineBegin(firstLine), mLineEnds[firstLine]);
+                }
+            }
+        } else {
+            ++mSkippedFeatures;
+            return;
+        }
+        if (mCoordinateLevel != expectedLevel) {
+            error("coordinates do not match geometry type '" + mGeometryType + "', skipped");
+            ++mSkippedFeatures;
+            return;
+        }
+        if (type == RenderType::TEXT && mFeature.mText.empty()) {
+            mFeature.mText = std::move(mName);
+        }
+        for (size_t i = 0; i < parts.size(); ++i) {
+            auto [begin, end] = parts[i];
+            if (type == RenderType::AREA && end - begin > 1 &&
+                mPositions[begin].mLongitude == mPositions[end - 1].mLongitude &&
+                mPositions[begin].mLatitude == mPositions[end - 1].mLatitude) {
+                // GeoJSON rings repeat the first position at the end, areas are closed when drawn
+                --end;
+            }
+            emit(type, Coordinates(mPositions.begin() + static_cast<ptrdiff_t>(begin),
+                                   mPositions.begin() + static_cast<ptrdiff_t>(end)), i + 1 == parts.size());
+        }
+    }
+
+    void RenderDataGeoJsonReader::emit(RenderType type, Coordinates &&coordinates, bool last) {
+        if (!mCallbacks.onFeature) {
+            return;
+        }
+        RenderData data = last ? std::move(mFeature) : mFeature;
+        data.mType = type;
+        data.mCoordinates = std::move(coordinates);
+        mCallbacks.onFeature(std::move(data));
+    }
+
+    void RenderDataGeoJsonReader::setProperty(const std::string &key, std::string_view value) {
+        // numeric properties are accepted as numbers or numeric strings, GIS exports often write the latter;
+        // an invalid number leaves the field at its default
+        double number = 0.0;
+        if (key == "fill") {
+            mFeature.mRawFill.assign(value);
+        } else if (key == "color") {
+            mFeature.mRawColor.assign(value);
+        } else if (key == "text") {
+            mFeature.mText.assign(value);
+        } else if (key == "name") {
+            mName.assign(value);
+        } else if (key == "size") {
+            if (parseNumber(value, number)) {
+                mFeature.mFontSize = static_cast<int>(std::lround(number));
+            }
+        } else if (key == "textAnchor") {
+            mFeature.mTextAnchor = stringToTextAnchor(std::string(value));
+        } else if (key == "textBackground") {
+            mFeature.mRawTextBackground.assign(value);
+        } else if (key == "textBackgroundStroke") {
+            mFeature.mRawTextBackgroundStroke.assign(value);
+        } else if (key == "textBackgroundStrokeWidth") {
+            if (parseNumber(value, number)) {
+                mFeature.mTextBackgroundStrokeWidth = static_cast<float>(number);
+            }
+        } else if (key == "zoom") {
+            if (parseNumber(value, number)) {
+                mFeature.mZoom = static_cast<int>(std::lround(number));
+            }
+        } else if (key == "maxZoom") {
+            if (parseNumber(value, number)) {
+                mFeature.mMaxZoom = static_cast<int>(std::lround(number));
+            }
+        } else if (key == "stroke") {
+            mFeature.mLineStyle = stringToLineStyle(std::string(value));
+            mHasStroke = true;
+        } else if (key == "lineStyle") {
+            if (!mHasStroke) {
+                mFeature.mLineStyle = stringToLineStyle(std::string(value));
+            }
+        } else if (key == "strokeWidth") {
+            if (parseNumber(value, number)) {
+                mFeature.mStrokeWidth = static_cast<float>(number);
+            }
+        } else if (key == "dashLength") {
+            if (parseNumber(value, number)) {
+                mDashLength = static_cast<float>(number);
+            }
+        } else if (key == "gapLength") {
+            if (parseNumber(value, number)) {
+                mGapLength = static_cast<float>(number);
+            }
+        }
+    }
+
+    void RenderDataGeoJsonReader::addCoordinateValue(Frame &frame, const double *value) {
+        if (frame.mChildLevel > 0) {
+            throw mParser->error("inconsistent coordinate nesting");
+        }
+        frame.mChildLevel = 0;
+        if (value == nullptr) {
+            // the whole position is dropped when it ends
+            mInvalidPosition = true;
+            return;
+        }
+        mNumbers.push_back(*value);
+    }
+
+    bool RenderDataGeoJsonReader::parseNumber(std::string_view text, double &result) {
+        const char *first = text.data();
+        const char *last = first + text.size();
+        if (first != last && *first == '+') {
+            ++first;
+        }
+        auto [ptr, ec] = std::from_chars(first, last, result);
+        if (ec != std::errc() || ptr != last || !std::isfinite(result)) {
+            // inside coordinates the position reports the error once it ends
+            if (mStack.back().mKind != FrameKind::CoordinateArray) {
+                error("invalid number for '" + mKey + "': " + std::string(text));
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void RenderDataGeoJsonReader::error(std::string message) {
+        mErrors.push_back({mParser->line(), std::move(message)});
+    }
+}
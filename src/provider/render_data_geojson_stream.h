@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_GEOJSON_STREAM_H
+#define RENDERPLUGIN_RENDER_DATA_GEOJSON_STREAM_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json_sax_parser.h"
+#include "render_data_definition.hpp"
+#include "render_data_field_decoder.h"
+
+namespace RenderPlugin {
+    /**
+     * 基于事件式 JSON 解析器的 GeoJSON 读取器，不构建文档树。
+     * 根节点须为 FeatureCollection；每个 Feature 解析完即通过 onFeature 交出（多部件几何每个部件一个要素）：
+     * Point / MultiPoint 为文字，LineString / MultiLineString 为线，Polygon / MultiPolygon 为区域（只取外环）；
+     * 几何为 null 或其他类型的要素跳过。properties 中的字段与 YAML 要素字段同名同义，文字缺省时取 name。
+     * 可选的顶层成员 color 为颜色表，逐项通过 onColor 交出，结束时调用 onColorsEnd。
+     * 与 YAML 解码一致，数据错误记录到 errors() 后继续：坐标无效时丢弃该坐标，数值字段无效时忽略该字段，
+     * 坐标层级与几何类型不符时跳过该要素；JSON 语法错误和坐标嵌套不一致抛出带行列号的 JsonParseError
+     */
+    class RenderDataGeoJsonReader : public JsonSaxHandler {
+    public:
+        struct Callbacks {
+            std::function<void(const std::string &name, const std::string &value)> onColor;
+            std::function<void()> onColorsEnd;
+            std::function<void(RenderData &&data)> onFeature;
+        };
+
+        explicit RenderDataGeoJsonReader(Callbacks callbacks);
+
+        void read(std::string_view text);
+
+        /** 文档中是否出现了 color / features 成员 */
+        [[nodiscard]] bool hasColors() const { return mHasColors; }
+
+        [[nodiscard]] bool hasFeatures() const { return mHasFeatures; }
+
+        /** 因几何为 null 或类型不支持而跳过的要素数 */
+        [[nodiscard]] size_t skippedFeatures() const { return mSkippedFeatures; }
+
+        /** 读取中记录的数据错误 */
+        [[nodiscard]] const std::vector<DecodeError> &errors() const { return mErrors; }
+
+        void onObjectStart() override;
+
+        void onObjectEnd() override;
+
+        void onArrayStart() override;
+
+        void onArrayEnd() override;
+
+        void onKey(std::string_view key) override;
+
+        void onString(std::string_view value) override;
+
+        void onNumber(std::string_view text) override;
+
+        void onBool(bool value) override;
+
+        void onNull() override;
+
+    private:
+        enum class FrameKind {
+            Root,
+            ColorMap,
+            FeatureArray,
+            Feature,
+            Geometry,
+            Properties,
+            CoordinateArray,
+            DashArray
+        };
+
+        struct Frame {
+            FrameKind mKind;
+            int mChildLevel{-1};    // CoordinateArray：子元素的嵌套层级，-1 尚未确定，0 为数值
+        };
+
+        Callbacks mCallbacks;
+        JsonSaxParser *mParser{nullptr};
+        std::vector<Frame> mStack;
+        std::string mKey;           // 当前成员名，值的事件紧随其后
+        int mSkipDepth{0};          // > 0 时正在跳过不关心的子树
+        bool mHasColors{false};
+        bool mHasFeatures{false};
+        size_t mSkippedFeatures{0};
+        std::vector<DecodeError> mErrors;
+
+        // 当前要素：properties 和几何的先后顺序不定，要素结束时再组合
+        RenderData mFeature;
+        std::string mName;
+        bool mHasStroke{false};
+        bool mHasDashKey{false};
+        float mDashLength{0.0f};
+        float mGapLength{0.0f};
+        std::string mGeometryType;
+        int mCoordinateLevel{-1};   // coordinates 根数组的层级：1 为点，2 为点数组，3 为环数组，4 为多边形数组
+        Coordinates mPositions;
+        std::vector<size_t> mLineEnds;      // 每条点序列在 mPositions 中的结束位置
+        std::vector<size_t> mPolygonEnds;   // 每个多边形在 mLineEnds 中的结束位置
+        std::vector<double> mNumbers;       // 当前坐标或 dash 数组中的数值
+        bool mInvalidPosition{false};       // 当前坐标中有不是有限数值的元素
+
+        void scalar(std::string_view value, bool isString);
+
+        void beginContainer(bool isObject);
+
+        void beginFeature();
+
+        void endFeature();
+
+        void emit(RenderType type, Coordinates &&coordinates, bool last);
+
+        void setProperty(const std::string &key, std::string_view value);
+
+        /** 坐标数组中的一个元素，value 为 nullptr 时元素不是有效数值 */
+        void addCoordinateValue(Frame &frame, const double *value);
+
+        /** 解析数值，失败时记录错误并返回 false */
+        bool parseNumber(std::string_view text, double &result);
+
+        void error(std::string message);
+    };
+}
+
+#endif
@@ -2,50 +2,236 @@
 // SPDX-License-Identifier: MIT
 
 #include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include "feature_store_binary.h"
+#include "hash_utils.h"
+#include "mapped_file.h"
 #include "render_data_provider.h"
 
 const RenderPlugin::Color DEFAULT_COLOR = RenderPlugin::Color();
 
 namespace RenderPlugin {
-    RenderDataProvider::RenderDataProvider() : mColorMap(nullptr), mRenderDataVector(nullptr), mIsLoaded(false) {}
+    RenderDataProvider::RenderDataProvider() : mColorMap(nullptr), mFeatureStore(nullptr), mIsLoaded(false) {}
 
     RenderDataProvider::~RenderDataProvider() {
         if (mIsLoaded) {
             mColorMap.reset();
-            mRenderDataVector.reset();
+            mFeatureStore.reset();
             mIsLoaded = false;
         }
     }
 
     Color RenderDataProvider::getColor(const std::string &name) {
-        if (mColorMap->find(name) == mColorMap->end()) {
+        // the color map is not kept when the data set comes from the binary cache
+        if (!mColorMap || mColorMap->find(name) == mColorMap->end()) {
             return DEFAULT_COLOR;
         }
         return mColorMap->at(name);
     }
 
-    std::shared_ptr<RenderDataVector> RenderDataProvider::getRenderData() {
-        return mRenderDataVector;
+    FeatureStorePtr RenderDataProvider::getFeatureStore() {
+        return mFeatureStore;
+    }
+
+    std::shared_ptr<const ColorMap> RenderDataProvider::getColorMap() const {
+        return mColorMap;
     }
 
     void RenderDataProvider::resetData() {
         mColorMap.reset();
-        mRenderDataVector.reset();
+        mFeatureStore.reset();
+        mPalette = Palette();
+        mSourceFiles.clear();
+        mPreviousStore.reset();
+        mLoadErrors.clear();
+        mLoadNotices.clear();
         mIsLoaded = false;
+        mSnapshots.publish(nullptr);
+    }
+
+    const std::vector<DecodeError> &RenderDataProvider::getLoadErrors() const {
+        return mLoadErrors;
+    }
+
+    const std::vector<std::string> &RenderDataProvider::getLoadNotices() const {
+        return mLoadNotices;
+    }
+
+    const std::vector<WatchedFile> &RenderDataProvider::getSourceFiles() const {
+        return mSourceFiles;
+    }
+
+    void RenderDataProvider::adoptData(RenderDataProvider &other) {
+        if (&other == this) {
+            return;
+        }
+        mColorMap = std::move(other.mColorMap);
+        mFeatureStore = std::move(other.mFeatureStore);
+        mSourceFiles = std::move(other.mSourceFiles);
+        mLoadErrors = std::move(other.mLoadErrors);
+        mLoadNotices = std::move(other.mLoadNotices);
+        mIsLoaded = other.mIsLoaded;
+        other.resetData();
+        // readers still drawing the previous data set keep it until their frame ends
+        mSnapshots.publish(mFeatureStore);
+    }
+
+    FeatureSnapshots::Reader RenderDataProvider::createSnapshotReader() {
+        return mSnapshots.createReader();
+    }
+
+    void RenderDataProvider::collectSnapshots() {
+        mSnapshots.collect();
+    }
+
+    PaletteIndex RenderDataProvider::processColorField(const std::string &rawColor) {
+        return resolveColorField(*mColorMap, mPalette, rawColor);
     }
 
-    Color RenderDataProvider::processColorField(const std::string &rawColor) {
+    void RenderDataProvider::resolveColors(RenderData &data) {
+        resolveColors(*mColorMap, mPalette, data);
+    }
+
+    PaletteIndex RenderDataProvider::resolveColorField(const ColorMap &colorMap, Palette &palette,
+                                                       const std::string &rawColor) {
         if (rawColor.empty()) {
             // if the color field is empty, we use the default color
-            return DEFAULT_COLOR;
+            return Palette::DEFAULT_INDEX;
         }
         if (rawColor.at(0) != '#') {
             // if the color value wasn't start with '#', it means that it's a color name
             // so we get the color from the color map
-            return this->getColor(rawColor);
+            auto it = colorMap.find(rawColor);
+            return palette.intern(it == colorMap.end() ? DEFAULT_COLOR : it->second);
         }
         // else we parse the color
-        return Color::fromColorString(rawColor);
+        return palette.intern(Color::fromColorString(rawColor));
+    }
+
+    void RenderDataProvider::resolveColors(const ColorMap &colorMap, Palette &palette, RenderData &data) {
+        if (data.mRawFill.empty() && data.mRawColor.empty()) {
+            data.mFill = Palette::DEFAULT_INDEX;
+            data.mColor = Palette::DEFAULT_INDEX;
+            return;
+        }
+        data.mFill = resolveColorField(colorMap, palette, data.mRawFill);
+        data.mColor = resolveColorField(colorMap, palette, data.mRawColor);
+        if (!data.mRawTextBackground.empty()) {
+            data.mTextBackground = resolveColorField(colorMap, palette, data.mRawTextBackground);
+        }
+        if (!data.mRawTextBackgroundStroke.empty()) {
+            data.mTextBackgroundStroke = resolveColorField(colorMap, palette, data.mRawTextBackgroundStroke);
+        }
+    }
+
+    void RenderDataProvider::addColor(const std::string &name, const std::string &value) {
+        if (name.empty() || value.empty()) {
+            return;
+        }
+        if (value.at(0) != '#') {
+            return;
+        }
+        mColorMap->emplace(name, Color::fromColorString(value));
+    }
+
+    void RenderDataProvider::setCoordinateStorage(CoordinateStorage storage) {
+        mCoordinateStorage = storage;
+    }
+
+    void RenderDataProvider::setBinaryCacheEnabled(bool enabled) {
+        mBinaryCacheEnabled = enabled;
+    }
+
+    void RenderDataProvider::setPreviousData(FeatureStorePtr previous) {
+        mPreviousStore = std::move(previous);
+    }
+
+    void RenderDataProvider::setBinaryCacheRebuild(bool rebuild) {
+        mBinaryCacheRebuild = rebuild;
+    }
+
+    fs::path RenderDataProvider::binaryCachePath(const fs::path &source) {
+        fs::path path = source;
+        path.replace_extension(BINARY_DATASET_EXTENSION);
+        return path;
+    }
+
+    FeatureStorePtr RenderDataProvider::readBinaryCache(const fs::path &source, uint64_t sourceHash) const {
+        if (!mBinaryCacheEnabled || mBinaryCacheRebuild) {
+            return nullptr;
+        }
+        return FeatureStoreBinary::load(binaryCachePath(source), sourceHash, mCoordinateStorage);
+    }
+
+    bool RenderDataProvider::loadCompiledDataset(const fs::path &path) {
+        WatchedFile source = WatchedFile::stat(path);
+        auto file = MappedFile::open(path);
+        if (!file) {
+            return false;
+        }
+        source.mContentHash = hashBytes(file->view());
+        // the store keeps the same mapping, the file is mapped once
+        auto store = FeatureStoreBinary::load(std::move(file));
+        if (!store) {
+            return false;
+        }
+        mColorMap = std::make_shared<ColorMap>();
+        mFeatureStore = std::move(store);
+        mSourceFiles = {std::move(source)};
+        mIsLoaded = true;
+        return true;
+    }
+
+    bool RenderDataProvider::loadSourceFile(const fs::path &path,
+                                            const std::function<bool(std::string_view text)> &parse) {
+        // take the stamp before reading, so that an edit during the load is seen as a change afterwards
+        WatchedFile stamp = WatchedFile::stat(path);
+        auto source = MappedFile::open(path);
+        if (!source) {
+            throw std::runtime_error("bad file: " + path.string());
+        }
+        const std::string_view text = source->view();
+        const uint64_t sourceHash = hashBytes(text);
+        stamp.mContentHash = sourceHash;
+
+        if (auto store = readBinaryCache(path, sourceHash)) {
+            mColorMap = std::make_shared<ColorMap>();
+            mFeatureStore = std::move(store);
+        } else {
+            if (!parse(text)) {
+                mPreviousStore.reset();
+                return false;
+            }
+            writeBinaryCache(mFeatureStore, path, sourceHash, mLoadNotices);
+        }
+        mPreviousStore.reset();
+        mSourceFiles = {std::move(stamp)};
+        mIsLoaded = true;
+        return true;
+    }
+
+    void RenderDataProvider::writeBinaryCache(FeatureStorePtr &store, const fs::path &source, uint64_t sourceHash,
+                                              std::vector<std::string> &notices) const {
+        if (!mBinaryCacheEnabled && !mBinaryCacheRebuild) {
+            return;
+        }
+        const fs::path cachePath = binaryCachePath(source);
+        std::error_code error;
+        if (!FeatureStoreBinary::write(*store, sourceHash, cachePath, error)) {
+            // not a load error, the parsed store is complete and stays in use; the next load tries again
+            std::string notice = "binary cache " + cachePath.string() + " not updated: " + error.message();
+            std::error_code ignored;
+            if (fs::exists(cachePath, ignored)) {
+                notice += " (the old cache may be mapped by another EuroScope instance)";
+            }
+            notices.push_back(notice + ", using the parsed data set");
+            return;
+        }
+        // the parsed store lives in this process's heap, the mapped cache is shared with other processes
+        if (auto mapped = FeatureStoreBinary::load(cachePath, sourceHash, store->coordinateStorage())) {
+            store = std::move(mapped);
+        }
     }
 
     bool RenderDataProvider::isLoaded() const {
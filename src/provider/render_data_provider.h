@@ -5,11 +5,22 @@
 #define RENDERPLUGIN_RENDER_DATA_PROVIDER_H
 
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "epoch_snapshot.h"
+#include "feature_store.h"
+#include "file_watcher.h"
 #include "render_data_definition.hpp"
+#include "render_data_field_decoder.h"
 
 namespace RenderPlugin {
     namespace fs = std::filesystem;
 
+    using FeatureSnapshots = EpochSnapshots<FeatureStore>;
+
     class RenderDataProvider {
     public:
         RenderDataProvider();
@@ -20,18 +31,105 @@ namespace RenderPlugin {
 
         Color getColor(const std::string &name);
 
-        std::shared_ptr<RenderDataVector> getRenderData();
+        FeatureStorePtr getFeatureStore();
+
+        /** 数据集的颜色表；从二进制数据集加载时颜色表为空 */
+        std::shared_ptr<const ColorMap> getColorMap() const;
 
         bool isLoaded() const;
 
         void resetData();
 
+        /** 上次加载时记录的数据错误（出错的字段被忽略、要素被跳过），从缓存加载时为空 */
+        const std::vector<DecodeError> &getLoadErrors() const;
+
+        /** 上次加载时不影响数据集的提示（如二进制缓存未能写入，数据集改用解析结果），只需写入日志 */
+        const std::vector<std::string> &getLoadNotices() const;
+
+        /** 上次成功加载时读取的全部源文件及其状态，用于热重载监视 */
+        const std::vector<WatchedFile> &getSourceFiles() const;
+
+        /**
+         * 接管另一个提供者已加载的数据集，对方随即清空。
+         * 用于后台加载：新数据集在独立的提供者中完整加载后再一次性替换，读取方不会看到加载中的状态
+         */
+        void adoptData(RenderDataProvider &other);
+
+        /**
+         * 登记一个渲染读取方（每个雷达屏幕一个）。读取方只能看到 adoptData / resetData 发布的数据集，
+         * 每帧固定一个快照而不加锁、不复制 shared_ptr；读取方须在提供者之前销毁
+         */
+        FeatureSnapshots::Reader createSnapshotReader();
+
+        /** 释放所有读取方都已不再使用的旧数据集，在发布数据集的线程中定期调用 */
+        void collectSnapshots();
+
+        /** 设置之后加载的数据集所使用的坐标存储方式 */
+        void setCoordinateStorage(CoordinateStorage storage);
+
+        /** 启用后加载时优先使用源文件旁的 .erpbin 缓存，缓存失效时从源文件加载并重写缓存 */
+        void setBinaryCacheEnabled(bool enabled);
+
+        /** 启用后不读取缓存，总是从源文件加载并重写缓存（用于离线编译） */
+        void setBinaryCacheRebuild(bool rebuild);
+
+        /**
+         * 增量重新加载：下次加载时源文本未变化的要素直接从此数据集复制，不再解码。
+         * 仅对支持按要素切分的加载方式有效，加载完成后释放
+         */
+        void setPreviousData(FeatureStorePtr previous);
+
+        /** 数据文件对应的二进制缓存路径：同目录、扩展名替换为 .erpbin */
+        static fs::path binaryCachePath(const fs::path &source);
+
     protected:
         bool mIsLoaded;
         std::shared_ptr<ColorMap> mColorMap;
-        std::shared_ptr<RenderDataVector> mRenderDataVector;
+        FeatureStorePtr mFeatureStore;
+        Palette mPalette; // palette of the data set being loaded, handed over to the feature store
+        CoordinateStorage mCoordinateStorage{CoordinateStorage::Double};
+        bool mBinaryCacheEnabled{false};
+        bool mBinaryCacheRebuild{false};
+        std::vector<WatchedFile> mSourceFiles;
+        FeatureStorePtr mPreviousStore;
+        std::vector<DecodeError> mLoadErrors;
+        std::vector<std::string> mLoadNotices;
+        FeatureSnapshots mSnapshots; // data set visible to the render readers
+
+        /** 源文件哈希与缓存一致时映射并返回缓存的存储，否则（或缓存未启用）返回 nullptr */
+        FeatureStorePtr readBinaryCache(const fs::path &source, uint64_t sourceHash) const;
+
+        /** 加载编译好的 .erpbin 数据集（由 erp-compile 生成），返回是否成功 */
+        bool loadCompiledDataset(const fs::path &path);
+
+        /**
+         * 单个源文件的加载流程：映射文件，缓存有效时直接使用缓存，
+         * 否则由 parse 解析文件内容（成功时设置 mFeatureStore 并返回 true）并重写缓存
+         */
+        bool loadSourceFile(const fs::path &path, const std::function<bool(std::string_view text)> &parse);
+
+        /**
+         * 将存储写入源文件对应的缓存，写入后 store 改为映射该缓存，解析得到的堆内存随之释放，
+         * 同一台机器上的其他 EuroScope 实例加载同一数据文件时共用这些页面。
+         * 写入失败（如目录只读，或 Windows 上旧缓存正被其他实例映射而无法替换）时 store 不变，
+         * 原因追加到 notices，数据集照常使用解析结果
+         */
+        void writeBinaryCache(FeatureStorePtr &store, const fs::path &source, uint64_t sourceHash,
+                              std::vector<std::string> &notices) const;
+
+        /** 解析颜色字段（颜色名称或 #RRGGBB）并放入调色板，返回调色板下标 */
+        PaletteIndex processColorField(const std::string &rawColor);
+
+        /** 解析要素的全部颜色字段，须在颜色表加载完成后调用 */
+        void resolveColors(RenderData &data);
+
+        /** 同上，颜色放入指定的调色板；颜色表只读，可在多个线程中各自使用独立的调色板并发调用 */
+        static PaletteIndex resolveColorField(const ColorMap &colorMap, Palette &palette, const std::string &rawColor);
+
+        static void resolveColors(const ColorMap &colorMap, Palette &palette, RenderData &data);
 
-        Color processColorField(const std::string &rawColor);
+        /** 颜色表中只接受 #RRGGBB 形式的颜色值，其余条目忽略 */
+        void addColor(const std::string &name, const std::string &value);
     };
 
     using ProviderPtr = std::shared_ptr<RenderDataProvider>;
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <cctype>
+
+#include "render_data_sector_provider.h"
+
+namespace {
+    std::string lowerExtension(const RenderPlugin::fs::path &path) {
+        std::string extension = path.extension().string();
+        for (char &c: extension) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return extension;
+    }
+}
+
+namespace RenderPlugin {
+    bool isSectorFilePath(const fs::path &path) {
+        const std::string extension = lowerExtension(path);
+        return extension == SCT_EXTENSION || extension == SCT2_EXTENSION || extension == ESE_EXTENSION;
+    }
+
+    RenderDataSectorProvider::RenderDataSectorProvider() : RenderDataProvider() {}
+
+    bool RenderDataSectorProvider::loadData(const fs::path &path) {
+        if (mIsLoaded) {
+            return false;
+        }
+        const std::string extension = lowerExtension(path);
+        const SectorFileFormat format = extension == ESE_EXTENSION ? SectorFileFormat::Ese : SectorFileFormat::Sct;
+        return loadSourceFile(path, [this, format](std::string_view text) { return loadText(text, format); });
+    }
+
+    bool RenderDataSectorProvider::loadText(std::string_view text, SectorFileFormat format) {
+        mColorMap = std::make_shared<ColorMap>();
+        mPalette = Palette();
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+
+        auto appendFeature = [this, &store](RenderData &&data) {
+            resolveColors(data);
+            store->append(std::move(data));
+        };
+        SectorFileReader reader(format, {
+                [this](const std::string &name, const std::string &value) { addColor(name, value); },
+                appendFeature
+        });
+        reader.read(text);
+        if (store->size() == 0) {
+            mColorMap.reset();
+            mPalette = Palette();
+            return false;
+        }
+        if (reader.lateColorCount() > 0) {
+            // some colors were defined after features that use them, read the features again with all names known
+            mPalette = Palette();
+            store = std::make_shared<FeatureStore>(mCoordinateStorage);
+            SectorFileReader featureReader(format, {nullptr, appendFeature});
+            featureReader.read(text);
+        }
+
+        store->setPalette(std::move(mPalette));
+        store->finalize();
+        mPalette = Palette();
+        mFeatureStore = std::move(store);
+        return true;
+    }
+}
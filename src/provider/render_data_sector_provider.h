@@ -0,0 +1,36 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_SECTOR_PROVIDER_H
+#define RENDERPLUGIN_RENDER_DATA_SECTOR_PROVIDER_H
+
+#include <string_view>
+
+#include "render_data_provider.h"
+#include "render_data_sector_reader.h"
+
+namespace RenderPlugin {
+    constexpr auto SCT_EXTENSION = ".sct";
+    constexpr auto SCT2_EXTENSION = ".sct2";
+    constexpr auto ESE_EXTENSION = ".ese";
+
+    /** 按扩展名（.sct / .sct2 / .ese，不区分大小写）判断数据文件是否为 EuroScope 扇区文件 */
+    bool isSectorFilePath(const fs::path &path);
+
+    /**
+     * EuroScope 扇区文件（.sct / .sct2）或扩展文件（.ese）数据集，
+     * 直接从映射的文件内容生成要素，取代用 transform.py 逐行转换坐标再手工编写 YAML 的流程。
+     * 各段与要素的对应关系见 SectorFileReader；#define 写在要素之后时整个文件按已知的颜色再读取一遍
+     */
+    class RenderDataSectorProvider : public RenderDataProvider {
+    public:
+        RenderDataSectorProvider();
+
+        virtual bool loadData(const fs::path &path) override;
+
+    private:
+        bool loadText(std::string_view text, SectorFileFormat format);
+    };
+}
+
+#endif
@@ -0,0 +1,489 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <numbers>
+#include <system_error>
+#include <utility>
+
+#include "render_data_sector_reader.h"
+
+namespace {
+    using namespace RenderPlugin;
+
+    constexpr auto DEFINE_PREFIX = "#define";
+    constexpr auto COORD_PREFIX = "COORD:";
+    constexpr auto DISPLAY_PREFIX = "DISPLAY:";
+    constexpr auto SECTORLINE_PREFIX = "SECTORLINE:";
+    constexpr auto CIRCLE_SECTORLINE_PREFIX = "CIRCLE_SECTORLINE:";
+
+    // CIRCLE_SECTORLINE 的半径单位为海里，圆按此段数展开为折线
+    constexpr double NAUTICAL_MILES_PER_DEGREE = 60.0;
+    constexpr int CIRCLE_SEGMENTS = 72;
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && isSpace(text.front())) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && isSpace(text.back())) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool startsWith(std::string_view text, std::string_view prefix) {
+        return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            const char x = a[i] >= 'a' && a[i] <= 'z' ? static_cast<char>(a[i] - 'a' + 'A') : a[i];
+            const char y = b[i] >= 'a' && b[i] <= 'z' ? static_cast<char>(b[i] - 'a' + 'A') : b[i];
+            if (x != y) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** 读取一段十进制整数（至少一位），不接受符号 */
+    bool readUnsigned(std::string_view &text, int &value) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || ptr == text.data() || value < 0) {
+            return false;
+        }
+        text.remove_prefix(static_cast<size_t>(ptr - text.data()));
+        return true;
+    }
+
+    /** 按冒号切分，不分配内存；超出 fields 容量的部分留在最后一个字段中 */
+    template<size_t N>
+    size_t splitFields(std::string_view line, std::string_view (&fields)[N]) {
+        size_t count = 0;
+        while (count + 1 < N) {
+            const size_t colon = line.find(':');
+            if (colon == std::string_view::npos) {
+                break;
+            }
+            fields[count++] = line.substr(0, colon);
+            line.remove_prefix(colon + 1);
+        }
+        fields[count++] = line;
+        return count;
+    }
+
+    bool sameCoordinate(const Coordinate &a, const Coordinate &b) {
+        return a.mLongitude == b.mLongitude && a.mLatitude == b.mLatitude;
+    }
+}
+
+namespace RenderPlugin {
+    bool parseSectorCoordinate(std::string_view text, bool latitude, double &degrees) {
+        text = trim(text);
+        if (text.size() < 2) {
+            return false;
+        }
+        double sign;
+        switch (text[0]) {
+            case 'N':
+            case 'n':
+            case 'E':
+            case 'e':
+                sign = 1.0;
+                break;
+            case 'S':
+            case 's':
+            case 'W':
+            case 'w':
+                sign = -1.0;
+                break;
+            default:
+                return false;
+        }
+        const char hemisphere = static_cast<char>(text[0] & ~0x20);
+        if (latitude != (hemisphere == 'N' || hemisphere == 'S')) {
+            return false;
+        }
+        text.remove_prefix(1);
+
+        // DDD.MM.SS.sss：度、分为整数，其余部分为带小数的秒
+        int wholeDegrees = 0;
+        int minutes = 0;
+        if (!readUnsigned(text, wholeDegrees) || text.empty() || text[0] != '.') {
+            return false;
+        }
+        text.remove_prefix(1);
+        if (!readUnsigned(text, minutes) || text.empty() || text[0] != '.') {
+            return false;
+        }
+        text.remove_prefix(1);
+        double seconds = 0.0;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+        if (ec != std::errc() || ptr != text.data() + text.size() || !(seconds >= 0.0) || seconds >= 60.0 ||
+            minutes >= 60) {
+            return false;
+        }
+        degrees = sign * (wholeDegrees + minutes / 60.0 + seconds / 3600.0);
+        return std::abs(degrees) <= (latitude ? 90.0 : 180.0);
+    }
+
+    bool parseSectorColor(std::string_view text, std::string &color) {
+        text = trim(text);
+        long value = 0;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (text.empty() || ec != std::errc() || ptr != text.data() + text.size() || value < 0 || value > 0xFFFFFF) {
+            return false;
+        }
+        // EuroScope 颜色为 Windows COLORREF：低字节为红色
+        static constexpr char HEX[] = "0123456789ABCDEF";
+        const int channels[] = {static_cast<int>(value & 0xFF), static_cast<int>((value >> 8) & 0xFF),
+                                static_cast<int>((value >> 16) & 0xFF)};
+        color.assign(1, '#');
+        for (const int channel: channels) {
+            color.push_back(HEX[channel >> 4]);
+            color.push_back(HEX[channel & 0xF]);
+        }
+        return true;
+    }
+
+    SectorFileReader::SectorFileReader(SectorFileFormat format, Callbacks callbacks)
+            : mFormat(format), mCallbacks(std::move(callbacks)) {}
+
+    void SectorFileReader::read(std::string_view text) {
+        mSection = Section::None;
+        mHasFeature = false;
+        mLateColorCount = 0;
+        mSkippedLines = 0;
+        mCurrent = RenderData();
+        while (!text.empty()) {
+            const size_t end = text.find('\n');
+            const std::string_view line = text.substr(0, end);
+            readLine(line);
+            if (end == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(end + 1);
+        }
+        flush();
+    }
+
+    void SectorFileReader::readLine(std::string_view line) {
+        // ';' 之后为注释；[LABELS] 和 [FREETEXT] 的文字中不会出现分号
+        const size_t comment = line.find(';');
+        if (comment != std::string_view::npos) {
+            line = line.substr(0, comment);
+        }
+        const std::string_view content = trim(line);
+        if (content.empty()) {
+            return;
+        }
+        if (content.front() == '[' && content.back() == ']') {
+            flush();
+            beginSection(content.substr(1, content.size() - 2));
+            return;
+        }
+        if (startsWith(content, DEFINE_PREFIX)) {
+            tokenize(content);
+            std::string color;
+            if (mTokens.size() < 3 || !parseSectorColor(mTokens[2], color)) {
+                ++mSkippedLines;
+                return;
+            }
+            if (mHasFeature) {
+                ++mLateColorCount;
+            }
+            if (mCallbacks.onColor) {
+                mCallbacks.onColor(std::string(mTokens[1]), color);
+            }
+            return;
+        }
+        if (mFormat == SectorFileFormat::Sct) {
+            readSctLine(line);
+        } else {
+            readEseLine(content);
+        }
+    }
+
+    void SectorFileReader::readSctLine(std::string_view line) {
+        const bool continuation = !line.empty() && isSpace(line.front());
+        Coordinate from;
+        Coordinate to;
+        switch (mSection) {
+            case Section::Points:
+                // VOR / NDB：名称 频率 纬度 经度；FIXES：名称 纬度 经度；AIRPORT：代码 频率 纬度 经度 空域类别
+                tokenize(line);
+                for (size_t first = 1; first + 1 < mTokens.size() && first <= 2; ++first) {
+                    double latitude = 0.0;
+                    double longitude = 0.0;
+                    if (parseSectorCoordinate(mTokens[first], true, latitude) &&
+                        parseSectorCoordinate(mTokens[first + 1], false, longitude)) {
+                        mNamedPoints.insert_or_assign(std::string(mTokens[0]), Coordinate(longitude, latitude));
+                        return;
+                    }
+                }
+                ++mSkippedLines;
+                return;
+            case Section::Segments:
+            case Section::PlainSegments: {
+                // [名称] 纬度 经度 纬度 经度 [颜色]：名称可含空格，因此从行尾取字段
+                tokenize(line);
+                const size_t count = mTokens.size();
+                if (mSection == Section::Segments && count >= 5 &&
+                    resolvePoint(mTokens[count - 5], mTokens[count - 4], from) &&
+                    resolvePoint(mTokens[count - 3], mTokens[count - 2], to)) {
+                    setColor(mTokens[count - 1]);
+                } else if (count >= 4 && resolvePoint(mTokens[count - 4], mTokens[count - 3], from) &&
+                           resolvePoint(mTokens[count - 2], mTokens[count - 1], to)) {
+                    mColor = SECTOR_DEFAULT_COLOR;
+                } else {
+                    ++mSkippedLines;
+                    return;
+                }
+                addSegment(from, to, mColor);
+                return;
+            }
+            case Section::Regions:
+                // 颜色 纬度 经度 开始一个区域，之后缩进的 纬度 经度 行为其余顶点；REGIONNAME 行只分隔区域
+                tokenize(line);
+                if (!mTokens.empty() && equalsIgnoreCase(mTokens[0], "REGIONNAME")) {
+                    flush();
+                    return;
+                }
+                if (!continuation && mTokens.size() >= 3 && resolvePoint(mTokens[1], mTokens[2], from)) {
+                    flush();
+                    setColor(mTokens[0]);
+                    mCurrent.mType = RenderType::AREA;
+                    mCurrent.mRawFill = mColor;
+                    mCurrent.mRawColor = mColor;
+                    mCurrent.mCoordinates.push_back(from);
+                } else if (mTokens.size() == 2 && !mCurrent.mCoordinates.empty() &&
+                           mCurrent.mType == RenderType::AREA && resolvePoint(mTokens[0], mTokens[1], from)) {
+                    mCurrent.mCoordinates.push_back(from);
+                } else {
+                    ++mSkippedLines;
+                }
+                return;
+            case Section::Labels: {
+                // "文字" 纬度 经度 颜色
+                const std::string_view content = trim(line);
+                const size_t close = content.size() > 1 && content[0] == '"' ? content.find('"', 1)
+                                                                            : std::string_view::npos;
+                if (close == std::string_view::npos) {
+                    ++mSkippedLines;
+                    return;
+                }
+                const std::string_view text = content.substr(1, close - 1);
+                tokenize(content.substr(close + 1));
+                if (mTokens.size() < 2 || !resolvePoint(mTokens[0], mTokens[1], from)) {
+                    ++mSkippedLines;
+                    return;
+                }
+                if (mTokens.size() >= 3) {
+                    setColor(mTokens[2]);
+                } else {
+                    mColor = SECTOR_DEFAULT_COLOR;
+                }
+                addText(text, from, mColor);
+                return;
+            }
+            default:
+                return;
+        }
+    }
+
+    void SectorFileReader::readEseLine(std::string_view line) {
+        std::string_view fields[5];
+        Coordinate coordinate;
+        switch (mSection) {
+            case Section::Airspace: {
+                if (startsWith(line, COORD_PREFIX)) {
+                    // COORD:纬度:经度，属于最近的 SECTORLINE
+                    const size_t count = splitFields(line, fields);
+                    if (count < 3 || mCurrent.mType != RenderType::LINE ||
+                        !resolvePoint(fields[1], fields[2], coordinate)) {
+                        ++mSkippedLines;
+                        return;
+                    }
+                    mCurrent.mCoordinates.push_back(coordinate);
+                    return;
+                }
+                if (startsWith(line, DISPLAY_PREFIX)) {
+                    // DISPLAY 行写在 SECTORLINE 与其 COORD 之间，只影响显示条件
+                    return;
+                }
+                flush();
+                if (startsWith(line, SECTORLINE_PREFIX)) {
+                    mCurrent.mType = RenderType::LINE;
+                    mCurrent.mRawColor = SECTOR_DEFAULT_COLOR;
+                    return;
+                }
+                if (!startsWith(line, CIRCLE_SECTORLINE_PREFIX)) {
+                    // SECTOR、OWNER、BORDER、DISPLAY 等描述管辖关系的行
+                    return;
+                }
+                // CIRCLE_SECTORLINE:名称:纬度:经度:半径 或 CIRCLE_SECTORLINE:名称:点名称:半径
+                const size_t count = splitFields(line, fields);
+                double radius = 0.0;
+                const std::string_view radiusText = trim(fields[count - 1]);
+                auto [ptr, ec] = std::from_chars(radiusText.data(), radiusText.data() + radiusText.size(), radius);
+                const bool validRadius = ec == std::errc() && ptr == radiusText.data() + radiusText.size() &&
+                                         radius > 0.0;
+                const bool resolved = (count == 5 && resolvePoint(fields[2], fields[3], coordinate)) ||
+                                      (count == 4 && resolvePoint(fields[2], fields[2], coordinate));
+                if (!validRadius || !resolved) {
+                    ++mSkippedLines;
+                    return;
+                }
+                RenderData circle;
+                circle.mType = RenderType::LINE;
+                circle.mRawColor = SECTOR_DEFAULT_COLOR;
+                circle.mCoordinates.reserve(CIRCLE_SEGMENTS + 1);
+                const double latitudeRadius = radius / NAUTICAL_MILES_PER_DEGREE;
+                const double longitudeRadius = latitudeRadius /
+                                               (std::max)(std::cos(coordinate.mLatitude * std::numbers::pi / 180.0),
+                                                        1e-6);
+                for (int i = 0; i <= CIRCLE_SEGMENTS; ++i) {
+                    const double angle = 2.0 * std::numbers::pi * (i % CIRCLE_SEGMENTS) / CIRCLE_SEGMENTS;
+                    circle.mCoordinates.emplace_back(coordinate.mLongitude + longitudeRadius * std::sin(angle),
+                                                     coordinate.mLatitude + latitudeRadius * std::cos(angle));
+                }
+                emit(std::move(circle));
+                return;
+            }
+            case Section::FreeText: {
+                // 纬度:经度:分组:文字
+                const size_t count = splitFields(line, fields);
+                if (count < 4 || !resolvePoint(fields[0], fields[1], coordinate)) {
+                    ++mSkippedLines;
+                    return;
+                }
+                // 文字中的冒号属于文字本身
+                const size_t textOffset = static_cast<size_t>(fields[3].data() - line.data());
+                addText(line.substr(textOffset), coordinate, SECTOR_DEFAULT_COLOR);
+                return;
+            }
+            default:
+                return;
+        }
+    }
+
+    void SectorFileReader::beginSection(std::string_view name) {
+        name = trim(name);
+        if (mFormat == SectorFileFormat::Ese) {
+            if (equalsIgnoreCase(name, "AIRSPACE")) {
+                mSection = Section::Airspace;
+            } else if (equalsIgnoreCase(name, "FREETEXT")) {
+                mSection = Section::FreeText;
+            } else {
+                mSection = Section::Other;
+            }
+            return;
+        }
+        if (equalsIgnoreCase(name, "VOR") || equalsIgnoreCase(name, "NDB") || equalsIgnoreCase(name, "FIXES") ||
+            equalsIgnoreCase(name, "AIRPORT")) {
+            mSection = Section::Points;
+        } else if (equalsIgnoreCase(name, "GEO") || equalsIgnoreCase(name, "SID") || equalsIgnoreCase(name, "STAR")) {
+            mSection = Section::Segments;
+        } else if (equalsIgnoreCase(name, "ARTCC") || equalsIgnoreCase(name, "ARTCC HIGH") ||
+                   equalsIgnoreCase(name, "ARTCC LOW") || equalsIgnoreCase(name, "HIGH AIRWAY") ||
+                   equalsIgnoreCase(name, "LOW AIRWAY")) {
+            mSection = Section::PlainSegments;
+        } else if (equalsIgnoreCase(name, "REGIONS")) {
+            mSection = Section::Regions;
+        } else if (equalsIgnoreCase(name, "LABELS")) {
+            mSection = Section::Labels;
+        } else {
+            // INFO、RUNWAY 等不生成要素的段
+            mSection = Section::Other;
+        }
+    }
+
+    bool SectorFileReader::resolvePoint(std::string_view latitude, std::string_view longitude,
+                                        Coordinate &coordinate) const {
+        if (parseSectorCoordinate(latitude, true, coordinate.mLatitude) &&
+            parseSectorCoordinate(longitude, false, coordinate.mLongitude)) {
+            return true;
+        }
+        // 按名称引用时两个字段都写点名称
+        latitude = trim(latitude);
+        if (latitude != trim(longitude)) {
+            return false;
+        }
+        const auto it = mNamedPoints.find(latitude);
+        if (it == mNamedPoints.end()) {
+            return false;
+        }
+        coordinate = it->second;
+        return true;
+    }
+
+    void SectorFileReader::setColor(std::string_view token) {
+        if (!parseSectorColor(token, mColor)) {
+            mColor.assign(token);
+        }
+    }
+
+    void SectorFileReader::addSegment(const Coordinate &from, const Coordinate &to, const std::string &color) {
+        // 扇区文件中的线按线段逐条书写，首尾相接且颜色相同的线段合并为一条线
+        if (mCurrent.mType == RenderType::LINE && !mCurrent.mCoordinates.empty() && mCurrent.mRawColor == color &&
+            sameCoordinate(mCurrent.mCoordinates.back(), from)) {
+            mCurrent.mCoordinates.push_back(to);
+            return;
+        }
+        flush();
+        mCurrent.mType = RenderType::LINE;
+        mCurrent.mRawColor = color;
+        mCurrent.mCoordinates.push_back(from);
+        mCurrent.mCoordinates.push_back(to);
+    }
+
+    void SectorFileReader::addText(std::string_view text, const Coordinate &coordinate, const std::string &color) {
+        flush();
+        RenderData data;
+        data.mType = RenderType::TEXT;
+        data.mText.assign(text);
+        data.mRawColor = color;
+        data.mCoordinates.push_back(coordinate);
+        emit(std::move(data));
+    }
+
+    void SectorFileReader::flush() {
+        if (!mCurrent.mCoordinates.empty()) {
+            emit(std::move(mCurrent));
+        }
+        mCurrent = RenderData();
+    }
+
+    void SectorFileReader::emit(RenderData &&data) {
+        mHasFeature = true;
+        if (mCallbacks.onFeature) {
+            mCallbacks.onFeature(std::move(data));
+        }
+    }
+
+    void SectorFileReader::tokenize(std::string_view line) {
+        mTokens.clear();
+        size_t i = 0;
+        while (i < line.size()) {
+            while (i < line.size() && isSpace(line[i])) {
+                ++i;
+            }
+            const size_t begin = i;
+            while (i < line.size() && !isSpace(line[i])) {
+                ++i;
+            }
+            if (i > begin) {
+                mTokens.push_back(line.substr(begin, i - begin));
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_SECTOR_READER_H
+#define RENDERPLUGIN_RENDER_DATA_SECTOR_READER_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "render_data_definition.hpp"
+
+namespace RenderPlugin {
+    /** 没有颜色字段的扇区数据（ARTCC、航路、ESE 扇区线和自由文字）使用的颜色 */
+    constexpr auto SECTOR_DEFAULT_COLOR = "#808080";
+
+    enum class SectorFileFormat : uint8_t {
+        Sct,    // .sct / .sct2 扇区文件
+        Ese     // .ese 扩展文件
+    };
+
+    /**
+     * 解析 EuroScope 扇区文件的经纬度（如 N039.54.00.000、E116.23.00.000），不分配内存。
+     * latitude 为 true 时只接受 N/S，否则只接受 E/W；格式或范围不符时返回 false
+     */
+    bool parseSectorCoordinate(std::string_view text, bool latitude, double &degrees);
+
+    /** 扇区文件的颜色值（十进制 BGR 整数，如 #define 中的 9076039）转为 #RRGGBB，不是整数时返回 false */
+    bool parseSectorColor(std::string_view text, std::string &color);
+
+    /**
+     * EuroScope 扇区文件读取器，逐行扫描映射的文件内容，直接生成要素：
+     * SCT 的 [GEO]、[SID]、[STAR]、[ARTCC*]、[*AIRWAY] 线段首尾相接且颜色相同时合并为一条线，
+     * [REGIONS] 为区域，[LABELS] 为文字；[VOR]、[NDB]、[FIXES]、[AIRPORT] 只登记名称，供坐标按名称引用；
+     * ESE 的 [AIRSPACE] 中每个 SECTORLINE / CIRCLE_SECTORLINE 为一条线，[FREETEXT] 为文字。
+     * #define 的颜色通过 onColor 交出（名称、#RRGGBB）。无法识别的行跳过并计数
+     */
+    class SectorFileReader {
+    public:
+        struct Callbacks {
+            std::function<void(const std::string &name, const std::string &value)> onColor;
+            std::function<void(RenderData &&data)> onFeature;
+        };
+
+        SectorFileReader(SectorFileFormat format, Callbacks callbacks);
+
+        void read(std::string_view text);
+
+        /** 出现在第一个要素之后的 #define 数量（此前的要素按名称解析颜色时尚不知道这些颜色） */
+        [[nodiscard]] size_t lateColorCount() const { return mLateColorCount; }
+
+        [[nodiscard]] size_t skippedLines() const { return mSkippedLines; }
+
+    private:
+        enum class Section {
+            None,
+            Points,     // VOR / NDB / FIXES / AIRPORT
+            Segments,   // GEO / SID / STAR：带颜色的线段
+            PlainSegments,  // ARTCC / AIRWAY：不带颜色的线段
+            Regions,
+            Labels,
+            Airspace,
+            FreeText,
+            Other
+        };
+
+        struct StringHash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+        };
+
+        SectorFileFormat mFormat;
+        Callbacks mCallbacks;
+        Section mSection{Section::None};
+        std::unordered_map<std::string, Coordinate, StringHash, std::equal_to<>> mNamedPoints;
+        std::vector<std::string_view> mTokens;
+        std::string mColor;         // 当前行的颜色（#define 名称或 #RRGGBB）
+        RenderData mCurrent;        // 正在合并的线或正在读取的区域
+        bool mHasFeature{false};
+        size_t mLateColorCount{0};
+        size_t mSkippedLines{0};
+
+        void readLine(std::string_view line);
+
+        void readSctLine(std::string_view line);
+
+        void readEseLine(std::string_view line);
+
+        void beginSection(std::string_view name);
+
+        /** 名称或 DMS 经纬度对解析为坐标，名称须在此前的 VOR / NDB / FIXES / AIRPORT 中出现过 */
+        bool resolvePoint(std::string_view latitude, std::string_view longitude, Coordinate &coordinate) const;
+
+        /** 颜色字段：#define 的名称或十进制 BGR 整数 */
+        void setColor(std::string_view token);
+
+        void addSegment(const Coordinate &from, const Coordinate &to, const std::string &color);
+
+        void addText(std::string_view text, const Coordinate &coordinate, const std::string &color);
+
+        void flush();
+
+        void emit(RenderData &&data);
+
+        void tokenize(std::string_view line);
+    };
+}
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include "render_data_definition.hpp"
+#include "render_data_yaml_chunks.h"
+
+namespace {
+    struct Line {
+        size_t mBegin;  // 行首偏移
+        size_t mEnd;    // 下一行行首偏移（含换行符）
+        size_t mIndent;
+        bool mBlank;    // 空行或纯注释行
+        bool mTab;      // 缩进中含制表符
+    };
+
+    Line readLine(std::string_view text, size_t begin) {
+        Line line{begin, text.size(), 0, true, false};
+        const size_t newline = text.find('\n', begin);
+        if (newline != std::string_view::npos) {
+            line.mEnd = newline + 1;
+        }
+        size_t i = begin;
+        while (i < line.mEnd && (text[i] == ' ' || text[i] == '\t')) {
+            line.mTab = line.mTab || text[i] == '\t';
+            ++i;
+        }
+        line.mIndent = i - begin;
+        line.mBlank = i >= line.mEnd || text[i] == '\n' || text[i] == '\r' || text[i] == '#';
+        return line;
+    }
+
+    bool isSequenceItem(std::string_view text, const Line &line) {
+        const size_t i = line.mBegin + line.mIndent;
+        if (i >= line.mEnd || text[i] != '-') {
+            return false;
+        }
+        return i + 1 >= line.mEnd || text[i + 1] == ' ' || text[i + 1] == '\n' || text[i + 1] == '\r';
+    }
+
+    bool isDocumentMarker(std::string_view text, const Line &line) {
+        const std::string_view head = text.substr(line.mBegin, 3);
+        return line.mIndent == 0 && (head == "---" || head == "...");
+    }
+
+    /** 是否为第 0 列的 "features:"，其后只允许空白或注释 */
+    bool isFeaturesKey(std::string_view text, const Line &line) {
+        const std::string_view key = RenderPlugin::FEATURE_KEY;
+        if (line.mIndent != 0 || text.substr(line.mBegin, key.size()) != key) {
+            return false;
+        }
+        size_t i = line.mBegin + key.size();
+        if (i >= line.mEnd || text[i] != ':') {
+            return false;
+        }
+        for (++i; i < line.mEnd; ++i) {
+            if (text[i] == '#') {
+                return true;
+            }
+            if (text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace RenderPlugin {
+    bool splitYamlFeatures(std::string_view text, YamlFeatureSplit &result) {
+        result = YamlFeatureSplit();
+
+        // locate the top level "features:" key
+        size_t offset = 0;
+        size_t lineNumber = 0;
+        bool found = false;
+        while (offset < text.size()) {
+            const Line line = readLine(text, offset);
+            offset = line.mEnd;
+            ++lineNumber;
+            if (isFeaturesKey(text, line)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+
+        // collect the start offset and line number of every item
+        const size_t bodyBegin = offset;
+        size_t bodyEnd = text.size();
+        size_t itemIndent = std::string_view::npos;
+        std::vector<std::pair<size_t, size_t>> items;
+        while (offset < text.size()) {
+            const Line line = readLine(text, offset);
+            if (line.mTab && !line.mBlank) {
+                return false;
+            }
+            if (!line.mBlank) {
+                if (isDocumentMarker(text, line)) {
+                    bodyEnd = line.mBegin;
+                    break;
+                }
+                if (itemIndent == std::string_view::npos) {
+                    if (!isSequenceItem(text, line)) {
+                        return false;
+                    }
+                    itemIndent = line.mIndent;
+                }
+                if (line.mIndent < itemIndent || (line.mIndent == itemIndent && !isSequenceItem(text, line))) {
+                    // next top level key
+                    bodyEnd = line.mBegin;
+                    break;
+                }
+                if (line.mIndent == itemIndent) {
+                    items.emplace_back(line.mBegin, lineNumber);
+                }
+            }
+            offset = line.mEnd;
+            ++lineNumber;
+        }
+        if (items.empty()) {
+            return false;
+        }
+
+        result.mItems.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t end = i + 1 < items.size() ? items[i + 1].first : bodyEnd;
+            result.mItems.push_back({text.substr(items[i].first, end - items[i].first), items[i].second, 1});
+        }
+
+        result.mRest.reserve(bodyBegin + text.size() - bodyEnd);
+        result.mRest.append(text.substr(0, bodyBegin));
+        result.mRest.append(text.substr(bodyEnd));
+        return true;
+    }
+
+    void groupYamlFeatures(const std::vector<YamlFeatureChunk> &items, size_t first, size_t last, size_t targetSize,
+                           std::vector<YamlFeatureChunk> &chunks) {
+        size_t chunkBegin = first;
+        size_t chunkSize = 0;
+        for (size_t i = first; i < last; ++i) {
+            if (i > chunkBegin && chunkSize + items[i].mText.size() > targetSize) {
+                chunks.push_back({{items[chunkBegin].mText.data(), chunkSize}, items[chunkBegin].mFirstLine,
+                                  i - chunkBegin});
+                chunkBegin = i;
+                chunkSize = 0;
+            }
+            // items are contiguous in the source text, so a run of them is a single view
+            chunkSize += items[i].mText.size();
+        }
+        if (last > chunkBegin) {
+            chunks.push_back({{items[chunkBegin].mText.data(), chunkSize}, items[chunkBegin].mFirstLine,
+                              last - chunkBegin});
+        }
+    }
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_YAML_CHUNKS_H
+#define RENDERPLUGIN_RENDER_DATA_YAML_CHUNKS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RenderPlugin {
+    /** features 序列中连续的若干个要素，本身是一个以块序列为根的合法 YAML 文档 */
+    struct YamlFeatureChunk {
+        std::string_view mText;
+        size_t mFirstLine;      // mText 第一行在原文件中的行号（从 0 开始）
+        size_t mFeatureCount;
+    };
+
+    struct YamlFeatureSplit {
+        std::string mRest;                      // 去掉 features 内容后的文档（保留 features: 键），用于解析颜色表
+        std::vector<YamlFeatureChunk> mItems;   // 每个要素一项，按文件顺序首尾相接，视图指向原文本
+    };
+
+    /**
+     * 按行扫描文档，将顶层块序列 features 按要素边界切分，每个要素的源文本（含其后的空行和注释）为一项。
+     * 只处理常规的块格式（features: 位于第 0 列，要素以同一缩进的 "- " 开头）；
+     * 流式写法、制表符缩进等无法安全切分的情况返回 false，调用方应整体解析。
+     */
+    bool splitYamlFeatures(std::string_view text, YamlFeatureSplit &result);
+
+    /**
+     * 将相邻的要素 items[first, last) 合并为若干段追加到 chunks，每段字节数不超过 targetSize
+     * （单个要素超过时独占一段）
+     */
+    void groupYamlFeatures(const std::vector<YamlFeatureChunk> &items, size_t first, size_t last, size_t targetSize,
+                           std::vector<YamlFeatureChunk> &chunks);
+}
+
+#endif
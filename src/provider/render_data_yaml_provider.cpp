@@ -1,56 +1,731 @@
 // Copyright (c) 2026 Half_nothing
 // SPDX-License-Identifier: MIT
 
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <spanstream>
+#include <unordered_map>
+
+#include "feature_store_binary.h"
+#include "hash_utils.h"
+#include "mapped_file.h"
+#include "render_data_yaml_chunks.h"
 #include "render_data_yaml_provider.h"
+#include "render_data_yaml_stream.h"
+#include "worker_pool.h"
+
+namespace {
+    // 小于此大小的文件切分和启动线程的开销大于收益，直接串行解析
+    constexpr size_t PARALLEL_MIN_FILE_SIZE = 256 * 1024;
+    // 每个线程分到的段数，段越多负载越均衡
+    constexpr size_t CHUNKS_PER_WORKER = 4;
+    constexpr auto NOT_REUSED = UINT32_MAX;
+    // 有数据错误的要素记录此哈希而不是源文本的哈希，重新加载时总是重新解码，错误随之再次报告且行号与文件一致
+    constexpr uint64_t UNREUSABLE_HASH = 0;
+
+    /** 要素源文本的哈希，不会与 UNREUSABLE_HASH 相同 */
+    uint64_t sourceHash(std::string_view text) {
+        const uint64_t hash = RenderPlugin::hashBytes(text);
+        return hash == UNREUSABLE_HASH ? 1 : hash;
+    }
+
+    /** 分段解码时每个要素的结果 */
+    enum class DecodeOutcome : uint8_t {
+        Clean,
+        WithErrors, // 保留，但有字段或坐标出错被忽略
+        Skipped
+    };
+
+    /** 颜色表内容的哈希（按名称有序遍历） */
+    uint64_t hashColorMap(const RenderPlugin::ColorMap &colorMap) {
+        uint64_t hash = colorMap.size();
+        for (const auto &[name, color]: colorMap) {
+            const unsigned char rgba[] = {color.red, color.green, color.blue, color.alpha};
+            hash = RenderPlugin::hashBytes(name, hash);
+            hash = RenderPlugin::hashBytes(rgba, sizeof(rgba), hash);
+        }
+        return hash;
+    }
+
+    /** 数值列表（坐标或 dash），有元素不是数值时记录错误并返回 false */
+    bool decodeNumbers(const YAML::Node &node, std::string_view key, RenderPlugin::FeatureFieldDecoder &decoder,
+                       std::vector<double> &numbers) {
+        numbers.clear();
+        for (const auto &element: node) {
+            const size_t line = static_cast<size_t>(element.Mark().line) + 1;
+            double number = 0.0;
+            if (!element.IsScalar()) {
+                decoder.error(line, element.IsNull() ? "unexpected null in number list"
+                                                     : "unexpected nested container in number list");
+                return false;
+            }
+            if (!decoder.parseNumber(key, element.Scalar(), line, number)) {
+                return false;
+            }
+            numbers.push_back(number);
+        }
+        return true;
+    }
+
+    /** 给 include 的文件中的错误记上文件路径，行号本身不能说明是哪个文件 */
+    void appendErrors(std::vector<RenderPlugin::DecodeError> &target, std::vector<RenderPlugin::DecodeError> &errors,
+                      const RenderPlugin::fs::path &file) {
+        for (auto &error: errors) {
+            error.mFile = file.string();
+            target.push_back(std::move(error));
+        }
+        errors.clear();
+    }
+}
 
 namespace RenderPlugin {
+    bool decodeFeatureNode(const YAML::Node &node, FeatureFieldDecoder &decoder, RenderData &data) {
+        const size_t line = static_cast<size_t>(node.Mark().line) + 1;
+        if (!node.IsMap()) {
+            decoder.error(line, "feature must be a map, skipped");
+            return false;
+        }
+        decoder.begin();
+        std::vector<double> numbers;
+        // one pass over the keys that are present, node["key"] would scan the map once per field
+        for (const auto &item: node) {
+            if (!item.first.IsScalar() || item.second.IsNull()) {
+                continue;
+            }
+            const std::string &key = item.first.Scalar();
+            const YAML::Node &value = item.second;
+            const size_t valueLine = static_cast<size_t>(value.Mark().line) + 1;
+            const FeatureField field = lookupFeatureField(key);
+            switch (field) {
+                case FeatureField::Coordinates:
+                    if (!value.IsSequence()) {
+                        decoder.error(valueLine, "'coordinates' must be a list of [longitude, latitude] pairs");
+                        break;
+                    }
+                    decoder.feature().mCoordinates.clear();
+                    decoder.feature().mCoordinates.reserve(value.size());
+                    for (const auto &pair: value) {
+                        const size_t pairLine = static_cast<size_t>(pair.Mark().line) + 1;
+                        if (!pair.IsSequence()) {
+                            decoder.error(pairLine, "coordinate must be a [longitude, latitude] pair, dropped");
+                        } else if (decodeNumbers(pair, key, decoder, numbers)) {
+                            decoder.addCoordinate(numbers, pairLine);
+                        }
+                    }
+                    break;
+                case FeatureField::Dash:
+                    if (value.IsSequence() && decodeNumbers(value, key, decoder, numbers)) {
+                        decoder.setDash(numbers);
+                    } else {
+                        decoder.setDash({});
+                    }
+                    break;
+                case FeatureField::Unknown:
+                    break;
+                default:
+                    if (value.IsScalar()) {
+                        decoder.setScalar(field, key, value.Scalar(), valueLine);
+                    } else {
+                        decoder.error(valueLine, "'" + key + "' must be a scalar, ignored");
+                    }
+                    break;
+            }
+        }
+        return decoder.finish(line, data);
+    }
+
     RenderDataYamlProvider::RenderDataYamlProvider() : RenderDataProvider() {}
 
     bool RenderDataYamlProvider::loadData(const fs::path &path) {
         if (mIsLoaded) {
             return false;
         }
+        if (path.extension() == BINARY_DATASET_EXTENSION) {
+            return loadCompiledDataset(path);
+        }
+        // take the stamp before reading, so that an edit during the load is seen as a change afterwards
+        WatchedFile stamp = WatchedFile::stat(path);
+        auto source = MappedFile::open(path);
+        if (!source) {
+            throw YAML::BadFile(path.string());
+        }
+        const std::string_view text = source->view();
+        const uint64_t sourceHash = hashBytes(text);
+        stamp.mContentHash = sourceHash;
 
-        YAML::Node config = YAML::LoadFile(path.string());
-        auto colorsNode = config[COLOR_KEY];
-        auto featuresNode = config[FEATURE_KEY];
-        if (!colorsNode || !featuresNode) {
+        // the cache of a file only holds its own features, included files have caches of their own
+        FeatureStorePtr store = readBinaryCache(path, sourceHash);
+        if (store) {
+            mColorMap = std::make_shared<ColorMap>();
+        } else {
+            if (!loadText(text)) {
+                mPreviousStore.reset();
+                return false;
+            }
+            store = std::move(mFeatureStore);
+            mIsLoaded = false;
+            writeBinaryCache(store, path, sourceHash, mLoadNotices);
+        }
+        std::vector<WatchedFile> sourceFiles{std::move(stamp)};
+        if (!store->includes().empty() && !loadIncludes(path, text, store, sourceFiles)) {
+            mPreviousStore.reset();
             return false;
         }
+        mPreviousStore.reset();
+        mFeatureStore = std::move(store);
+        mSourceFiles = std::move(sourceFiles);
+        mIsLoaded = true;
+        return true;
+    }
 
+    bool RenderDataYamlProvider::loadIncludes(const fs::path &path, std::string_view mainText, FeatureStorePtr &store,
+                                              std::vector<WatchedFile> &sourceFiles) {
+        struct IncludedFile {
+            fs::path mPath;
+            WatchedFile mStamp;
+            std::shared_ptr<const MappedFile> mFile;
+            FeatureStorePtr mStore;
+            std::vector<DecodeError> mErrors;
+            std::vector<std::string> mNotices;
+        };
+        std::vector<IncludedFile> files;
+        std::vector<size_t> decodeIndices;
+        for (const auto &include: store->includes()) {
+            IncludedFile file;
+            file.mPath = path.parent_path() / fs::path(std::u8string(include.begin(), include.end()));
+            file.mStamp = WatchedFile::stat(file.mPath);
+            file.mFile = MappedFile::open(file.mPath);
+            if (!file.mFile) {
+                throw YAML::BadFile(file.mPath.string());
+            }
+            file.mStamp.mContentHash = hashBytes(file.mFile->view());
+            // colors are resolved with the main file's color table, a cache built with another one is stale
+            auto cached = readBinaryCache(file.mPath, file.mStamp.mContentHash);
+            if (cached && cached->colorTableHash() == store->colorTableHash()) {
+                file.mStore = std::move(cached);
+            } else {
+                decodeIndices.push_back(files.size());
+            }
+            files.push_back(std::move(file));
+        }
+
+        if (!decodeIndices.empty()) {
+            if (!mColorMap || hashColorMap(*mColorMap) != store->colorTableHash()) {
+                loadColorTable(mainText);
+            }
+            const ColorMap &colorMap = *mColorMap;
+            const uint64_t colorTableHash = hashColorMap(colorMap);
+            const FeatureStore *previous = mPreviousStore.get();
+            auto decodeFile = [&, this](IncludedFile &file, size_t workerCount) {
+                try {
+                    file.mStore = decodeIncludedFile(file.mFile->view(), colorMap, colorTableHash, previous,
+                                                     workerCount, file.mErrors);
+                } catch (const YAML::ParserException &e) {
+                    // the position alone does not tell which file is broken
+                    throw YAML::ParserException(e.mark, file.mPath.string() + ": " + e.msg);
+                }
+                if (file.mStore) {
+                    writeBinaryCache(file.mStore, file.mPath, file.mStamp.mContentHash, file.mNotices);
+                }
+            };
+            // a single file uses all workers for its own chunks, several files are decoded one per worker
+            const size_t workerCount = this->workerCount();
+            if (decodeIndices.size() == 1 || workerCount < 2) {
+                for (size_t index: decodeIndices) {
+                    decodeFile(files[index], workerCount);
+                }
+            } else {
+                WorkerPool pool((std::min)(workerCount, decodeIndices.size()));
+                std::vector<std::future<void>> results;
+                results.reserve(decodeIndices.size());
+                for (size_t index: decodeIndices) {
+                    results.push_back(pool.submit([&decodeFile, &file = files[index]] { decodeFile(file, 1); }));
+                }
+                for (auto &result: results) {
+                    result.get();
+                }
+            }
+            for (size_t index: decodeIndices) {
+                if (!files[index].mStore) {
+                    return false;
+                }
+                appendErrors(mLoadErrors, files[index].mErrors, files[index].mPath);
+                mLoadNotices.insert(mLoadNotices.end(), files[index].mNotices.begin(), files[index].mNotices.end());
+            }
+        }
+
+        // the main file's features come first, followed by the included files in order
+        size_t featureCount = store->size();
+        size_t coordinateCount = store->coordinateCount();
+        bool hasSourceHashes = store->sourceHashes().size() == store->size();
+        for (const auto &file: files) {
+            featureCount += file.mStore->size();
+            coordinateCount += file.mStore->coordinateCount();
+            hasSourceHashes = hasSourceHashes && file.mStore->sourceHashes().size() == file.mStore->size();
+        }
+        auto combined = std::make_shared<FeatureStore>(mCoordinateStorage);
+        combined->reserve(featureCount, coordinateCount);
+        if (mPreviousStore) {
+            // start from the previous palette, so that the render backends can keep their brushes
+            combined->setPalette(mPreviousStore->palette());
+        }
+        const size_t paletteSize = combined->palette().size();
+        std::vector<uint64_t> sourceHashes;
+        auto append = [&](const FeatureStore &part) {
+            FeatureImporter importer(*combined, part);
+            for (FeatureStore::FeatureIndex i = 0; i < part.size(); ++i) {
+                importer.import(i);
+            }
+            if (hasSourceHashes) {
+                sourceHashes.insert(sourceHashes.end(), part.sourceHashes().begin(), part.sourceHashes().end());
+            }
+        };
+        append(*store);
+        for (auto &file: files) {
+            append(*file.mStore);
+            sourceFiles.push_back(std::move(file.mStamp));
+        }
+        if (mPreviousStore && combined->palette().size() != paletteSize) {
+            Palette palette = combined->palette();
+            palette.renewId();
+            combined->setPalette(std::move(palette));
+        }
+        if (hasSourceHashes) {
+            combined->setSourceHashes(sourceHashes);
+        }
+        combined->setColorTableHash(store->colorTableHash());
+        combined->finalize();
+        store = std::move(combined);
+        return true;
+    }
+
+    void RenderDataYamlProvider::loadColorTable(std::string_view text) {
         mColorMap = std::make_shared<ColorMap>();
-        for (const auto &item: colorsNode) {
-            auto key = item.first.as<std::string>();
-            auto value = item.second.as<std::string>();
-            if (key.empty() || value.empty()) {
-                continue;
+        RenderDataYamlStreamReader reader({
+                [this](const std::string &name, const std::string &value) { addColor(name, value); },
+                nullptr,
+                nullptr
+        });
+        try {
+            // the features are skipped when the document can be split
+            YamlFeatureSplit split;
+            if (splitYamlFeatures(text, split)) {
+                std::ispanstream in(split.mRest);
+                reader.read(in);
+            } else {
+                std::ispanstream in(text);
+                reader.read(in);
+            }
+        } catch (const YamlStreamUnsupported &) {
+            mColorMap = std::make_shared<ColorMap>();
+            std::ispanstream in(text);
+            YAML::Node config = YAML::Load(in);
+            for (const auto &item: config[COLOR_KEY]) {
+                addColor(item.first.as<std::string>(), item.second.as<std::string>());
+            }
+        }
+    }
+
+    FeatureStorePtr RenderDataYamlProvider::decodeIncludedFile(std::string_view text, const ColorMap &colorMap,
+                                                               uint64_t colorTableHash, const FeatureStore *previous,
+                                                               size_t workerCount,
+                                                               std::vector<DecodeError> &errors) const {
+        YamlFeatureSplit split;
+        if (splitYamlFeatures(text, split)) {
+            if (auto store = decodeFeatures(split.mItems, colorMap, colorTableHash, previous, workerCount, errors)) {
+                return store;
+            }
+        }
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+        Palette palette;
+        try {
+            RenderDataYamlStreamReader reader({
+                    nullptr,
+                    nullptr,
+                    [&](RenderData &&data) {
+                        resolveColors(colorMap, palette, data);
+                        store->append(std::move(data));
+                    }
+            });
+            std::ispanstream in(text);
+            reader.read(in);
+            if (!reader.hasFeatures()) {
+                return nullptr;
+            }
+            errors.insert(errors.end(), reader.errors().begin(), reader.errors().end());
+        } catch (const YamlStreamUnsupported &) {
+            std::ispanstream in(text);
+            YAML::Node config = YAML::Load(in);
+            auto featuresNode = config[FEATURE_KEY];
+            if (!featuresNode) {
+                return nullptr;
+            }
+            store = std::make_shared<FeatureStore>(mCoordinateStorage);
+            palette = Palette();
+            FeatureFieldDecoder decoder(errors);
+            for (const auto &node: featuresNode) {
+                RenderData element;
+                if (decodeFeatureNode(node, decoder, element)) {
+                    resolveColors(colorMap, palette, element);
+                    store->append(std::move(element));
+                }
+            }
+        }
+        store->setPalette(std::move(palette));
+        store->setColorTableHash(colorTableHash);
+        store->finalize();
+        return store;
+    }
+
+    size_t RenderDataYamlProvider::workerCount() const {
+        return mWorkerCount > 0 ? mWorkerCount : WorkerPool::defaultThreadCount();
+    }
+
+    bool RenderDataYamlProvider::loadText(std::string_view text) {
+        if (mLoadMode == YamlLoadMode::Dom) {
+            return loadDataDom(text);
+        }
+        try {
+            if (mLoadMode == YamlLoadMode::Parallel) {
+                return loadDataParallel(text);
             }
-            if (value.at(0) != '#') {
+            std::ispanstream in(text);
+            return loadDataStream(in);
+        } catch (const YamlStreamUnsupported &) {
+            // the file uses anchors / merge keys, let yaml-cpp resolve them
+            return loadDataDom(text);
+        }
+    }
+
+    bool RenderDataYamlProvider::loadDataStream(std::istream &in) {
+        mColorMap = std::make_shared<ColorMap>();
+        mPalette = Palette();
+        mIncludes.clear();
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+
+        // colors are resolved by name, so features that appear before the color section are kept until it ends
+        bool colorsReady = false;
+        RenderDataVector pending;
+        auto appendFeature = [this, &store](RenderData &&data) {
+            resolveColors(data);
+            store->append(std::move(data));
+        };
+
+        RenderDataYamlStreamReader reader({
+                [this](const std::string &name, const std::string &value) { addColor(name, value); },
+                [&]() {
+                    colorsReady = true;
+                    for (auto &element: pending) {
+                        appendFeature(std::move(element));
+                    }
+                    pending = RenderDataVector();
+                },
+                [&](RenderData &&data) {
+                    if (colorsReady) {
+                        appendFeature(std::move(data));
+                    } else {
+                        pending.push_back(std::move(data));
+                    }
+                },
+                [this](const std::string &path) { mIncludes.push_back(path); }
+        });
+        reader.read(in);
+        mLoadErrors = reader.errors();
+        if (!reader.hasColors() || (!reader.hasFeatures() && mIncludes.empty())) {
+            mColorMap.reset();
+            mPalette = Palette();
+            return false;
+        }
+
+        publish(std::move(store));
+        return true;
+    }
+
+    bool RenderDataYamlProvider::loadDataParallel(std::string_view text) {
+        YamlFeatureSplit split;
+        if (!splitYamlFeatures(text, split)) {
+            std::ispanstream in(text);
+            return loadDataStream(in);
+        }
+
+        // the color map is needed by every chunk, parse the rest of the document first
+        mColorMap = std::make_shared<ColorMap>();
+        mPalette = Palette();
+        mIncludes.clear();
+        RenderDataYamlStreamReader restReader({
+                [this](const std::string &name, const std::string &value) { addColor(name, value); },
+                nullptr,
+                nullptr,
+                [this](const std::string &path) { mIncludes.push_back(path); }
+        });
+        std::ispanstream restIn(split.mRest);
+        restReader.read(restIn);
+        if (!restReader.hasColors() || !restReader.hasFeatures()) {
+            mColorMap.reset();
+            return false;
+        }
+        mLoadErrors.clear();
+        auto store = decodeFeatures(split.mItems, *mColorMap, hashColorMap(*mColorMap), mPreviousStore.get(),
+                                    workerCount(), mLoadErrors);
+        if (!store) {
+            // the split did not match the parser's view of the document, decode it as a whole
+            std::ispanstream in(text);
+            return loadDataStream(in);
+        }
+        store->setIncludes(mIncludes);
+        mPalette = Palette();
+        mFeatureStore = std::move(store);
+        mIsLoaded = true;
+        return true;
+    }
+
+    FeatureStorePtr RenderDataYamlProvider::decodeFeatures(const std::vector<YamlFeatureChunk> &items,
+                                                           const ColorMap &colorMap, uint64_t colorTableHash,
+                                                           const FeatureStore *previous, size_t workerCount,
+                                                           std::vector<DecodeError> &errors) const {
+        // features whose source text is unchanged since the previous data set are copied from it instead of decoded
+        std::vector<uint64_t> hashes;
+        hashes.reserve(items.size());
+        for (const auto &item: items) {
+            hashes.push_back(sourceHash(item.mText));
+        }
+        std::vector<FeatureStore::FeatureIndex> reuse(items.size(), NOT_REUSED);
+        if (previous && previous->coordinateStorage() == mCoordinateStorage &&
+            previous->colorTableHash() == colorTableHash && previous->sourceHashes().size() == previous->size()) {
+            const auto previousHashes = previous->sourceHashes();
+            std::unordered_map<uint64_t, FeatureStore::FeatureIndex> lookup;
+            lookup.reserve(previousHashes.size());
+            for (size_t i = 0; i < previousHashes.size(); ++i) {
+                if (previousHashes[i] != UNREUSABLE_HASH) {
+                    lookup.emplace(previousHashes[i], static_cast<FeatureStore::FeatureIndex>(i));
+                }
+            }
+            for (size_t i = 0; i < items.size(); ++i) {
+                auto it = lookup.find(hashes[i]);
+                if (it != lookup.end()) {
+                    reuse[i] = it->second;
+                }
+            }
+        }
+
+        // group the runs of features that have to be decoded into chunks of roughly equal size
+        size_t decodeSize = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            decodeSize += reuse[i] == NOT_REUSED ? items[i].mText.size() : 0;
+        }
+        const bool parallel = workerCount > 1 && decodeSize >= PARALLEL_MIN_FILE_SIZE;
+        const size_t targetSize = parallel ? decodeSize / (workerCount * CHUNKS_PER_WORKER) + 1 : decodeSize + 1;
+        std::vector<YamlFeatureChunk> chunks;
+        for (size_t i = 0; i < items.size();) {
+            if (reuse[i] != NOT_REUSED) {
+                ++i;
                 continue;
             }
-            mColorMap->emplace(key, Color::fromColorString(value));
+            size_t end = i + 1;
+            while (end < items.size() && reuse[end] == NOT_REUSED) {
+                ++end;
+            }
+            groupYamlFeatures(items, i, end, targetSize, chunks);
+            i = end;
         }
 
-        // we have already written a specialized template to process the render data
-        // so we can use the YAML::Node::as<T>() method to process the render data automatically
-        mRenderDataVector = std::make_shared<RenderDataVector>(featuresNode.as<RenderDataVector>());
-        for (auto &element: *mRenderDataVector) {
-            if (element.mRawFill.empty() && element.mRawColor.empty()) {
-                element.mFill = Color();
-                element.mColor = Color();
+        // every chunk is decoded into its own store with its own palette and label table,
+        // so color resolution and UTF-8 conversion run on the workers as well
+        std::vector<FeatureStore> chunkStores;
+        chunkStores.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunkStores.emplace_back(mCoordinateStorage);
+        }
+        std::vector<std::vector<DecodeOutcome>> chunkOutcomes(chunks.size());
+        std::vector<std::vector<DecodeError>> chunkErrors(chunks.size());
+        auto decodeChunk = [&colorMap](const YamlFeatureChunk &chunk, FeatureStore &store,
+                                       std::vector<DecodeOutcome> &outcomes, std::vector<DecodeError> &chunkErrors) {
+            Palette palette;
+            // the errors recorded since the previous feature ended belong to the feature that ends now
+            const std::vector<DecodeError> *readerErrors = nullptr;
+            size_t errorCount = 0;
+            auto settle = [&](bool skipped) {
+                const bool hasErrors = readerErrors->size() != errorCount;
+                errorCount = readerErrors->size();
+                outcomes.push_back(skipped ? DecodeOutcome::Skipped
+                                           : hasErrors ? DecodeOutcome::WithErrors : DecodeOutcome::Clean);
+            };
+            RenderDataYamlStreamReader reader({
+                    nullptr,
+                    nullptr,
+                    [&](RenderData &&data) {
+                        resolveColors(colorMap, palette, data);
+                        store.append(std::move(data));
+                        settle(false);
+                    },
+                    nullptr,
+                    [&] { settle(true); }
+            });
+            readerErrors = &reader.errors();
+            outcomes.reserve(chunk.mFeatureCount);
+            std::ispanstream in(chunk.mText);
+            try {
+                reader.readFeatures(in);
+            } catch (const YAML::ParserException &e) {
+                // report the position in the original file
+                YAML::Mark mark = e.mark;
+                mark.line += static_cast<int>(chunk.mFirstLine);
+                throw YAML::ParserException(mark, e.msg);
+            }
+            store.setPalette(std::move(palette));
+            // report the lines of the original file
+            chunkErrors = reader.errors();
+            for (auto &error: chunkErrors) {
+                error.mLine += chunk.mFirstLine;
+            }
+        };
+        if (parallel && chunks.size() > 1) {
+            WorkerPool pool((std::min)(workerCount, chunks.size()));
+            std::vector<std::future<void>> results;
+            results.reserve(chunks.size());
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                results.push_back(pool.submit([&decodeChunk, &chunk = chunks[i], &store = chunkStores[i],
+                                                      &outcomes = chunkOutcomes[i], &chunkError = chunkErrors[i]] {
+                    decodeChunk(chunk, store, outcomes, chunkError);
+                }));
+            }
+            for (auto &result: results) {
+                result.get();
+            }
+        } else {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                decodeChunk(chunks[i], chunkStores[i], chunkOutcomes[i], chunkErrors[i]);
+            }
+        }
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            // every feature is either kept or skipped, another count means the split does not match the parser
+            if (chunkOutcomes[i].size() != chunks[i].mFeatureCount) {
+                return nullptr;
+            }
+        }
+        for (auto &chunkError: chunkErrors) {
+            errors.insert(errors.end(), std::make_move_iterator(chunkError.begin()),
+                          std::make_move_iterator(chunkError.end()));
+        }
+
+        // assemble in file order, the order of features is the draw order
+        size_t coordinateCount = 0;
+        for (const auto &chunkStore: chunkStores) {
+            coordinateCount += chunkStore.coordinateCount();
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            coordinateCount += reuse[i] != NOT_REUSED ? previous->coordinates(reuse[i]).size() : 0;
+        }
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+        store->reserve(items.size(), coordinateCount);
+        if (previous) {
+            // start from the previous palette, so that the render backends can keep their brushes
+            store->setPalette(previous->palette());
+        }
+        const size_t paletteSize = store->palette().size();
+        std::optional<FeatureImporter> previousImporter;
+        if (previous) {
+            previousImporter.emplace(*store, *previous);
+        }
+        // skipped features have no entry in the store, and so no source hash either
+        std::vector<uint64_t> storeHashes;
+        storeHashes.reserve(items.size());
+        size_t chunkIndex = 0;
+        size_t chunkItem = 0;
+        FeatureStore::FeatureIndex chunkFeature = 0;
+        std::optional<FeatureImporter> chunkImporter;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (reuse[i] != NOT_REUSED) {
+                previousImporter->import(reuse[i]);
+                storeHashes.push_back(hashes[i]);
                 continue;
             }
-            element.mFill = this->processColorField(element.mRawFill);
-            element.mColor = this->processColorField(element.mRawColor);
-            if (!element.mRawTextBackground.empty()) {
-                element.mTextBackground = this->processColorField(element.mRawTextBackground);
+            if (!chunkImporter || chunkItem == chunkOutcomes[chunkIndex].size()) {
+                if (chunkImporter) {
+                    ++chunkIndex;
+                }
+                chunkImporter.emplace(*store, chunkStores[chunkIndex]);
+                chunkItem = 0;
+                chunkFeature = 0;
             }
-            if (!element.mRawTextBackgroundStroke.empty()) {
-                element.mTextBackgroundStroke = this->processColorField(element.mRawTextBackgroundStroke);
+            const DecodeOutcome outcome = chunkOutcomes[chunkIndex][chunkItem++];
+            if (outcome == DecodeOutcome::Skipped) {
+                continue;
             }
+            chunkImporter->import(chunkFeature++);
+            storeHashes.push_back(outcome == DecodeOutcome::Clean ? hashes[i] : UNREUSABLE_HASH);
         }
+        if (previous && store->palette().size() != paletteSize) {
+            Palette palette = store->palette();
+            palette.renewId();
+            store->setPalette(std::move(palette));
+        }
+        store->setSourceHashes(storeHashes);
+        store->setColorTableHash(colorTableHash);
+        // the bounds and the tile pyramid are rebuilt for the whole data set rather than patched for the edit
+        store->finalize();
+        return store;
+    }
 
-        mIsLoaded = true;
+    bool RenderDataYamlProvider::loadDataDom(std::string_view text) {
+        std::ispanstream in(text);
+        YAML::Node config = YAML::Load(in);
+        auto colorsNode = config[COLOR_KEY];
+        auto featuresNode = config[FEATURE_KEY];
+        auto includeNode = config[INCLUDE_KEY];
+        mIncludes.clear();
+        if (includeNode && includeNode.IsScalar()) {
+            mIncludes.push_back(includeNode.as<std::string>());
+        } else if (includeNode && includeNode.IsSequence()) {
+            mIncludes = includeNode.as<std::vector<std::string>>();
+        }
+        if (!colorsNode || (!featuresNode && mIncludes.empty())) {
+            return false;
+        }
+
+        mColorMap = std::make_shared<ColorMap>();
+        mPalette = Palette();
+        for (const auto &item: colorsNode) {
+            addColor(item.first.as<std::string>(), item.second.as<std::string>());
+        }
+
+        // malformed features are reported and skipped instead of failing the whole data set
+        mLoadErrors.clear();
+        FeatureFieldDecoder decoder(mLoadErrors);
+        RenderDataVector renderData;
+        if (featuresNode && featuresNode.IsSequence()) {
+            renderData.reserve(featuresNode.size());
+        }
+        size_t coordinateCount = 0;
+        for (const auto &node: featuresNode) {
+            RenderData element;
+            if (decodeFeatureNode(node, decoder, element)) {
+                coordinateCount += element.mCoordinates.size();
+                resolveColors(element);
+                renderData.push_back(std::move(element));
+            }
+        }
+
+        // move the decoded features into the columnar store, the temporary vector is released afterwards
+        auto store = std::make_shared<FeatureStore>(mCoordinateStorage);
+        store->reserve(renderData.size(), coordinateCount);
+        for (auto &element: renderData) {
+            store->append(std::move(element));
+        }
+        publish(std::move(store));
         return true;
     }
+
+    void RenderDataYamlProvider::publish(FeatureStorePtr store) {
+        store->setPalette(std::move(mPalette));
+        store->setColorTableHash(hashColorMap(*mColorMap));
+        store->setIncludes(std::move(mIncludes));
+        mIncludes.clear();
+        store->finalize();
+        mPalette = Palette();
+        mFeatureStore = std::move(store);
+        mIsLoaded = true;
+    }
 }
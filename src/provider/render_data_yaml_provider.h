@@ -4,16 +4,118 @@
 #ifndef RENDERPLUGIN_RENDER_DATA_YAML_PROVIDER_H
 #define RENDERPLUGIN_RENDER_DATA_YAML_PROVIDER_H
 
-#include "render_data_provider.h"
-#include "string_utils.h"
+#include <cctype>
+#include <istream>
+#include <string>
+#include <string_view>
 #include <yaml-cpp/yaml.h>
 
+#include "render_data_field_decoder.h"
+#include "render_data_provider.h"
+#include "render_data_yaml_chunks.h"
+
 namespace RenderPlugin {
+    /**
+     * YAML 数据集加载方式；插件配置 LoadMode 默认为 parallel，
+     * Provider 未设置加载方式或配置值无法识别时使用 Stream
+     */
+    enum class YamlLoadMode : uint8_t {
+        Stream,     // 事件流解析，要素直接写入存储，不构建 YAML::Node 树
+        Parallel,   // features 段按要素边界切分后在工作线程中流式解析，再按文件顺序合并（插件默认）
+        Dom         // YAML::LoadFile 构建完整文档树后再转换
+    };
+
+    constexpr auto YAML_LOAD_MODE_STREAM = "stream";
+    constexpr auto YAML_LOAD_MODE_PARALLEL = "parallel";
+    constexpr auto YAML_LOAD_MODE_DOM = "dom";
+
+    inline std::string yamlLoadModeToString(YamlLoadMode mode) {
+        switch (mode) {
+            case YamlLoadMode::Parallel:
+                return YAML_LOAD_MODE_PARALLEL;
+            case YamlLoadMode::Dom:
+                return YAML_LOAD_MODE_DOM;
+            default:
+                return YAML_LOAD_MODE_STREAM;
+        }
+    }
+
+    inline YamlLoadMode stringToYamlLoadMode(const std::string &str) {
+        std::string lower;
+        lower.reserve(str.size());
+        for (unsigned char c: str) {
+            lower.push_back(static_cast<char>(std::tolower(c)));
+        }
+        if (lower == YAML_LOAD_MODE_PARALLEL) {
+            return YamlLoadMode::Parallel;
+        }
+        if (lower == YAML_LOAD_MODE_DOM) {
+            return YamlLoadMode::Dom;
+        }
+        return YamlLoadMode::Stream;
+    }
+
+    /**
+     * 按字段表单次遍历要素的映射节点（DOM 加载使用），每个键只查找一次；
+     * 数据错误记录到 decoder 而不抛出，要素须跳过时返回 false
+     */
+    bool decodeFeatureNode(const YAML::Node &node, FeatureFieldDecoder &decoder, RenderData &data);
+
     class RenderDataYamlProvider : public RenderDataProvider {
     public:
         RenderDataYamlProvider();
 
         virtual bool loadData(const fs::path &path) override;
+
+        /** 流式加载遇到别名、合并键等不支持的特性时会自动回退到 DOM 加载 */
+        void setLoadMode(YamlLoadMode mode) { mLoadMode = mode; }
+
+        [[nodiscard]] YamlLoadMode getLoadMode() const { return mLoadMode; }
+
+        /** 并行加载使用的线程数，0 表示硬件线程数 */
+        void setWorkerCount(size_t count) { mWorkerCount = count; }
+
+    private:
+        YamlLoadMode mLoadMode{YamlLoadMode::Stream};
+        size_t mWorkerCount{0};
+        std::vector<std::string> mIncludes; // include entries of the file being parsed
+
+        /** 按加载方式解析 YAML 文本 */
+        bool loadText(std::string_view text);
+
+        bool loadDataStream(std::istream &in);
+
+        bool loadDataParallel(std::string_view text);
+
+        bool loadDataDom(std::string_view text);
+
+        /**
+         * 解码切分后的要素并按文件顺序组装为存储；previous 中源文本相同的要素直接复制。
+         * 切分结果与解析器不一致时返回 nullptr，调用方应整体解析
+         */
+        FeatureStorePtr decodeFeatures(const std::vector<YamlFeatureChunk> &items, const ColorMap &colorMap,
+                                       uint64_t colorTableHash, const FeatureStore *previous, size_t workerCount,
+                                       std::vector<DecodeError> &errors) const;
+
+        /**
+         * 加载 store（主文件自身的要素）include 的文件，各文件使用各自的缓存，
+         * 按主文件、include 顺序合并后替换 store，并将各文件加入 sourceFiles
+         */
+        bool loadIncludes(const fs::path &path, std::string_view mainText, FeatureStorePtr &store,
+                          std::vector<WatchedFile> &sourceFiles);
+
+        /** 只解析颜色表（主文件来自缓存而 include 的文件需要解码时） */
+        void loadColorTable(std::string_view text);
+
+        /** 解码 include 的文件，其中的颜色表被忽略；文件没有 features 段时返回 nullptr */
+        FeatureStorePtr decodeIncludedFile(std::string_view text, const ColorMap &colorMap, uint64_t colorTableHash,
+                                           const FeatureStore *previous, size_t workerCount,
+                                           std::vector<DecodeError> &errors) const;
+
+        size_t workerCount() const;
+
+        /** 将加载完成的调色板交给存储并发布 */
+        void publish(FeatureStorePtr store);
     };
 }
 
@@ -54,7 +156,7 @@ namespace YAML {
             }
             // text type support text content
             if (!rhs.mText.empty()) {
-                node["text"] = RenderPlugin::WstringToUtf8(rhs.mText);
+                node["text"] = rhs.mText;
             }
             // text type support font size
             if (rhs.mFontSize > 0) {
@@ -73,6 +175,9 @@ namespace YAML {
                 node["textBackgroundStrokeWidth"] = rhs.mTextBackgroundStrokeWidth;
             }
             node["zoom"] = rhs.mZoom;
+            if (rhs.mMaxZoom > 0) {
+                node["maxZoom"] = rhs.mMaxZoom;
+            }
             node["stroke"] = RenderPlugin::lineStyleToString(rhs.mLineStyle);
             if (rhs.mStrokeWidth > 0.0f) node["strokeWidth"] = rhs.mStrokeWidth;
             if (rhs.mDashLength > 0.0f || rhs.mGapLength > 0.0f) {
@@ -83,57 +188,10 @@ namespace YAML {
         }
 
         static bool decode(const Node &node, RenderPlugin::RenderData &rhs) {
-            if (!node.IsMap()) {
-                return false;
-            }
-            rhs.mType = RenderPlugin::stringToRenderType(node["type"].as<std::string>());
-            rhs.mCoordinates = node["coordinates"].as<RenderPlugin::Coordinates>();
-            if (node["fill"]) {
-                rhs.mRawFill = node["fill"].as<std::string>();
-            }
-            if (node["color"]) {
-                rhs.mRawColor = node["color"].as<std::string>();
-            }
-            if (node["text"]) {
-                rhs.mText = RenderPlugin::Utf8ToWstring(node["text"].as<std::string>());
-            }
-            if (node["size"]) {
-                rhs.mFontSize = node["size"].as<int>();
-            }
-            if (node["textAnchor"]) {
-                rhs.mTextAnchor = RenderPlugin::stringToTextAnchor(node["textAnchor"].as<std::string>());
-            }
-            if (node["textBackground"]) {
-                rhs.mRawTextBackground = node["textBackground"].as<std::string>();
-            }
-            if (node["textBackgroundStroke"]) {
-                rhs.mRawTextBackgroundStroke = node["textBackgroundStroke"].as<std::string>();
-            }
-            if (node["textBackgroundStrokeWidth"]) {
-                rhs.mTextBackgroundStrokeWidth = node["textBackgroundStrokeWidth"].as<float>();
-            }
-            if (node["zoom"]) {
-                rhs.mZoom = node["zoom"].as<int>();
-            }
-            if (node["stroke"]) {
-                rhs.mLineStyle = RenderPlugin::stringToLineStyle(node["stroke"].as<std::string>());
-            } else if (node["lineStyle"]) {
-                rhs.mLineStyle = RenderPlugin::stringToLineStyle(node["lineStyle"].as<std::string>());
-            }
-            if (node["strokeWidth"]) {
-                rhs.mStrokeWidth = node["strokeWidth"].as<float>();
-            }
-            if (node["dash"]) {
-                auto dash = node["dash"];
-                if (dash.IsSequence() && dash.size() >= 2) {
-                    rhs.mDashLength = dash[0].as<float>();
-                    rhs.mGapLength = dash[1].as<float>();
-                }
-            } else {
-                if (node["dashLength"]) rhs.mDashLength = node["dashLength"].as<float>();
-                if (node["gapLength"]) rhs.mGapLength = node["gapLength"].as<float>();
-            }
-            return true;
+            // as<RenderData>() reports a failed conversion by throwing, so any data error fails it
+            std::vector<RenderPlugin::DecodeError> errors;
+            RenderPlugin::FeatureFieldDecoder decoder(errors);
+            return RenderPlugin::decodeFeatureNode(node, decoder, rhs) && errors.empty();
         }
     };
 }
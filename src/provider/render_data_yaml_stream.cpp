@@ -0,0 +1,307 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <utility>
+#include <yaml-cpp/exceptions.h>
+#include <yaml-cpp/parser.h>
+
+#include "render_data_yaml_stream.h"
+
+namespace {
+    constexpr auto MERGE_KEY = "<<";
+}
+
+namespace RenderPlugin {
+    RenderDataYamlStreamReader::RenderDataYamlStreamReader(Callbacks callbacks) : mCallbacks(std::move(callbacks)) {}
+
+    void RenderDataYamlStreamReader::read(std::istream &in) {
+        YAML::Parser parser(in);
+        parser.HandleNextDocument(*this);
+    }
+
+    void RenderDataYamlStreamReader::readFeatures(std::istream &in) {
+        mFeaturesOnly = true;
+        read(in);
+    }
+
+    void RenderDataYamlStreamReader::OnDocumentStart(const YAML::Mark &) {
+        mStack.clear();
+        mSkipDepth = 0;
+    }
+
+    void RenderDataYamlStreamReader::OnDocumentEnd() {
+        mDocumentDone = true;
+    }
+
+    void RenderDataYamlStreamReader::OnNull(const YAML::Mark &mark, YAML::anchor_t) {
+        scalar(mark, {}, true);
+    }
+
+    void RenderDataYamlStreamReader::OnAlias(const YAML::Mark &mark, YAML::anchor_t) {
+        // 不关心的部分中的别名可以直接忽略
+        if (mSkipDepth > 0) {
+            return;
+        }
+        throw YamlStreamUnsupported("YAML alias at line " + std::to_string(mark.line + 1) +
+                                    " is not supported by the streaming reader");
+    }
+
+    void RenderDataYamlStreamReader::OnScalar(const YAML::Mark &mark, const std::string &, YAML::anchor_t,
+                                              const std::string &value) {
+        scalar(mark, value, false);
+    }
+
+    void RenderDataYamlStreamReader::OnSequenceStart(const YAML::Mark &mark, const std::string &, YAML::anchor_t,
+                                                     YAML::EmitterStyle::value) {
+        beginContainer(mark, false);
+    }
+
+    void RenderDataYamlStreamReader::OnSequenceEnd() {
+        endContainer();
+    }
+
+    void RenderDataYamlStreamReader::OnMapStart(const YAML::Mark &mark, const std::string &, YAML::anchor_t,
+                                                YAML::EmitterStyle::value) {
+        beginContainer(mark, true);
+    }
+
+    void RenderDataYamlStreamReader::OnMapEnd() {
+        endContainer();
+    }
+
+    void RenderDataYamlStreamReader::scalar(const YAML::Mark &mark, const std::string &value, bool isNull) {
+        if (mSkipDepth > 0 || mStack.empty()) {
+            return;
+        }
+        Frame &frame = mStack.back();
+        switch (frame.mKind) {
+            case FrameKind::RootMap:
+                if (frame.mExpectKey) {
+                    frame.mKey = value;
+                    frame.mExpectKey = false;
+                    return;
+                }
+                // color / features 的值不是容器时视为空
+                if (frame.mKey == COLOR_KEY) {
+                    mHasColors = true;
+                    if (mCallbacks.onColorsEnd) {
+                        mCallbacks.onColorsEnd();
+                    }
+                } else if (frame.mKey == FEATURE_KEY) {
+                    mHasFeatures = true;
+                } else if (frame.mKey == INCLUDE_KEY && !isNull && mCallbacks.onInclude) {
+                    mCallbacks.onInclude(value);
+                }
+                frame.mExpectKey = true;
+                return;
+            case FrameKind::ColorMap:
+                if (frame.mExpectKey) {
+                    frame.mKey = value;
+                    frame.mExpectKey = false;
+                    return;
+                }
+                if (!isNull && mCallbacks.onColor) {
+                    mCallbacks.onColor(frame.mKey, value);
+                }
+                frame.mExpectKey = true;
+                return;
+            case FrameKind::FeatureMap:
+                if (frame.mExpectKey) {
+                    if (value == MERGE_KEY) {
+                        throw YamlStreamUnsupported("YAML merge key at line " + std::to_string(mark.line + 1) +
+                                                    " is not supported by the streaming reader");
+                    }
+                    frame.mKey = value;
+                    frame.mField = lookupFeatureField(value);
+                    frame.mExpectKey = false;
+                    return;
+                }
+                if (!isNull || frame.mField == FeatureField::Dash) {
+                    mDecoder.setScalar(frame.mField, frame.mKey, value, lineOf(mark));
+                }
+                frame.mExpectKey = true;
+                return;
+            case FrameKind::CoordinatePair:
+            case FrameKind::DashSeq: {
+                // the list is dropped as a whole when one of its values is not a number
+                double number = 0.0;
+                const bool isDash = frame.mKind == FrameKind::DashSeq;
+                if (isNull) {
+                    mDecoder.error(lineOf(mark), "unexpected null in number list");
+                    frame.mInvalid = true;
+                } else if (mDecoder.parseNumber(isDash ? "dash" : "coordinates", value, lineOf(mark), number)) {
+                    mNumbers.push_back(number);
+                } else {
+                    frame.mInvalid = true;
+                }
+                return;
+            }
+            case FrameKind::FeatureSeq:
+                skipFeature(mark);
+                return;
+            case FrameKind::CoordinateSeq:
+                mDecoder.error(lineOf(mark), "coordinate must be a [longitude, latitude] pair, dropped");
+                return;
+            case FrameKind::IncludeSeq:
+                if (!isNull && mCallbacks.onInclude) {
+                    mCallbacks.onInclude(value);
+                }
+                return;
+        }
+    }
+
+    void RenderDataYamlStreamReader::beginContainer(const YAML::Mark &mark, bool isMap) {
+        if (mSkipDepth > 0) {
+            ++mSkipDepth;
+            return;
+        }
+        if (mStack.empty()) {
+            if (mDocumentDone) {
+                ++mSkipDepth;
+            } else if (mFeaturesOnly && !isMap) {
+                mHasFeatures = true;
+                mStack.push_back({FrameKind::FeatureSeq, mark});
+            } else if (!mFeaturesOnly && isMap) {
+                mStack.push_back({FrameKind::RootMap, mark});
+            } else {
+                ++mSkipDepth;
+            }
+            return;
+        }
+
+        Frame &frame = mStack.back();
+        switch (frame.mKind) {
+            case FrameKind::RootMap:
+            case FrameKind::ColorMap:
+            case FrameKind::FeatureMap: {
+                if (frame.mExpectKey) {
+                    // 非标量的键：连同其后的值一起跳过
+                    frame.mKey.clear();
+                    frame.mField = FeatureField::Unknown;
+                    frame.mExpectKey = false;
+                    ++mSkipDepth;
+                    return;
+                }
+                const std::string key = frame.mKey;
+                const FeatureField field = frame.mField;
+                frame.mExpectKey = true;
+                if (frame.mKind == FrameKind::RootMap && key == COLOR_KEY) {
+                    mHasColors = true;
+                    if (isMap) {
+                        mStack.push_back({FrameKind::ColorMap, mark});
+                        return;
+                    }
+                    if (mCallbacks.onColorsEnd) {
+                        mCallbacks.onColorsEnd();
+                    }
+                } else if (frame.mKind == FrameKind::RootMap && key == FEATURE_KEY) {
+                    mHasFeatures = true;
+                    if (!isMap) {
+                        mStack.push_back({FrameKind::FeatureSeq, mark});
+                        return;
+                    }
+                } else if (frame.mKind == FrameKind::RootMap && !isMap && key == INCLUDE_KEY) {
+                    mStack.push_back({FrameKind::IncludeSeq, mark});
+                    return;
+                } else if (frame.mKind == FrameKind::FeatureMap && field == FeatureField::Coordinates) {
+                    if (!isMap) {
+                        mDecoder.feature().mCoordinates.clear();
+                        mStack.push_back({FrameKind::CoordinateSeq, mark});
+                        return;
+                    }
+                    mDecoder.error(lineOf(mark), "'coordinates' must be a list of [longitude, latitude] pairs");
+                } else if (frame.mKind == FrameKind::FeatureMap && field == FeatureField::Dash) {
+                    if (!isMap) {
+                        mNumbers.clear();
+                        mStack.push_back({FrameKind::DashSeq, mark});
+                        return;
+                    }
+                    mDecoder.setDash({});
+                } else if (frame.mKind == FrameKind::FeatureMap && field != FeatureField::Unknown) {
+                    mDecoder.error(lineOf(mark), "'" + key + "' must be a scalar, ignored");
+                }
+                ++mSkipDepth;
+                return;
+            }
+            case FrameKind::FeatureSeq:
+                if (!isMap) {
+                    skipFeature(mark);
+                    ++mSkipDepth;
+                    return;
+                }
+                mDecoder.begin();
+                mStack.push_back({FrameKind::FeatureMap, mark});
+                return;
+            case FrameKind::CoordinateSeq:
+                if (isMap) {
+                    mDecoder.error(lineOf(mark), "coordinate must be a [longitude, latitude] pair, dropped");
+                    ++mSkipDepth;
+                    return;
+                }
+                mNumbers.clear();
+                mStack.push_back({FrameKind::CoordinatePair, mark});
+                return;
+            case FrameKind::CoordinatePair:
+            case FrameKind::DashSeq:
+                mDecoder.error(lineOf(mark), "unexpected nested container in number list");
+                frame.mInvalid = true;
+                ++mSkipDepth;
+                return;
+            case FrameKind::IncludeSeq:
+                throw YAML::ParserException(mark, "include entry must be a file path");
+        }
+    }
+
+    void RenderDataYamlStreamReader::endContainer() {
+        if (mSkipDepth > 0) {
+            --mSkipDepth;
+            return;
+        }
+        if (mStack.empty()) {
+            return;
+        }
+        const Frame frame = std::move(mStack.back());
+        mStack.pop_back();
+        switch (frame.mKind) {
+            case FrameKind::ColorMap:
+                if (mCallbacks.onColorsEnd) {
+                    mCallbacks.onColorsEnd();
+                }
+                break;
+            case FrameKind::FeatureMap:
+                endFeature(frame.mMark);
+                break;
+            case FrameKind::CoordinatePair:
+                if (!frame.mInvalid) {
+                    mDecoder.addCoordinate(mNumbers, lineOf(frame.mMark));
+                }
+                break;
+            case FrameKind::DashSeq:
+                mDecoder.setDash(frame.mInvalid ? std::vector<double>() : mNumbers);
+                break;
+            case FrameKind::RootMap:
+            case FrameKind::FeatureSeq:
+            case FrameKind::CoordinateSeq:
+            case FrameKind::IncludeSeq:
+                break;
+        }
+    }
+
+    void RenderDataYamlStreamReader::endFeature(const YAML::Mark &mark) {
+        RenderData data;
+        if (!mDecoder.finish(lineOf(mark), data)) {
+            if (mCallbacks.onFeatureSkipped) {
+                mCallbacks.onFeatureSkipped();
+            }
+        } else if (mCallbacks.onFeature) {
+            mCallbacks.onFeature(std::move(data));
+        }
+    }
+
+    void RenderDataYamlStreamReader::skipFeature(const YAML::Mark &mark) {
+        mDecoder.error(lineOf(mark), "feature must be a map, skipped");
+        if (mCallbacks.onFeatureSkipped) {
+            mCallbacks.onFeatureSkipped();
+        }
+    }
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_RENDER_DATA_YAML_STREAM_H
+#define RENDERPLUGIN_RENDER_DATA_YAML_STREAM_H
+
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/mark.h>
+
+#include "render_data_definition.hpp"
+#include "render_data_field_decoder.h"
+
+namespace RenderPlugin {
+    /** 流式读取器不支持的 YAML 特性（别名、合并键），调用方应回退到 DOM 加载 */
+    class YamlStreamUnsupported : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * 基于 yaml-cpp 事件解析器的数据集读取器，不构建 YAML::Node 树。
+     * color 段逐项通过 onColor 交出，段结束时调用 onColorsEnd；
+     * features 段每解析完一个要素即通过 onFeature 交出，内存占用与单个要素大小相关，而不是文件大小；
+     * include 段（单个路径或路径列表）逐项通过 onInclude 交出。
+     * 字段由 FeatureFieldDecoder 解码，与 DOM 加载一致；字段值、坐标或要素结构有误时记录到 errors() 并继续，
+     * YAML 语法错误抛出带行列号的 YAML::ParserException，遇到别名或合并键抛出 YamlStreamUnsupported。
+     */
+    class RenderDataYamlStreamReader : public YAML::EventHandler {
+    public:
+        struct Callbacks {
+            std::function<void(const std::string &name, const std::string &value)> onColor;
+            std::function<void()> onColorsEnd;
+            std::function<void(RenderData &&data)> onFeature;
+            std::function<void(const std::string &path)> onInclude{};
+            // 要素因结构或字段错误被整体跳过时调用，与 onFeature 一起按文件顺序覆盖每个要素
+            std::function<void()> onFeatureSkipped{};
+        };
+
+        explicit RenderDataYamlStreamReader(Callbacks callbacks);
+
+        /** 解析输入流中的第一个文档 */
+        void read(std::istream &in);
+
+        /** 解析以要素序列为根的文档（即 features 段的一部分，见 splitYamlFeatures） */
+        void readFeatures(std::istream &in);
+
+        /** 文档中是否出现了 color / features 键 */
+        [[nodiscard]] bool hasColors() const { return mHasColors; }
+
+        [[nodiscard]] bool hasFeatures() const { return mHasFeatures; }
+
+        /** 解码时记录的数据错误，行号为输入中的行号 */
+        [[nodiscard]] const std::vector<DecodeError> &errors() const { return mErrors; }
+
+        void OnDocumentStart(const YAML::Mark &mark) override;
+
+        void OnDocumentEnd() override;
+
+        void OnNull(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+
+        void OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+
+        void OnScalar(const YAML::Mark &mark, const std::string &tag, YAML::anchor_t anchor,
+                      const std::string &value) override;
+
+        void OnSequenceStart(const YAML::Mark &mark, const std::string &tag, YAML::anchor_t anchor,
+                             YAML::EmitterStyle::value style) override;
+
+        void OnSequenceEnd() override;
+
+        void OnMapStart(const YAML::Mark &mark, const std::string &tag, YAML::anchor_t anchor,
+                        YAML::EmitterStyle::value style) override;
+
+        void OnMapEnd() override;
+
+    private:
+        enum class FrameKind {
+            RootMap,
+            ColorMap,
+            FeatureSeq,
+            FeatureMap,
+            CoordinateSeq,
+            CoordinatePair,
+            DashSeq,
+            IncludeSeq
+        };
+
+        struct Frame {
+            FrameKind mKind;
+            YAML::Mark mMark;
+            bool mExpectKey{true};
+            std::string mKey{};
+            FeatureField mField{FeatureField::Unknown};    // FeatureMap：当前键对应的字段
+            bool mInvalid{false};   // CoordinatePair / DashSeq：含有非数值的元素
+        };
+
+        Callbacks mCallbacks;
+        std::vector<Frame> mStack;
+        int mSkipDepth{0};      // > 0 时正在跳过不关心的子树
+        bool mDocumentDone{false};
+        bool mFeaturesOnly{false};  // 文档根节点即要素序列
+        bool mHasColors{false};
+        bool mHasFeatures{false};
+
+        std::vector<DecodeError> mErrors;
+        FeatureFieldDecoder mDecoder{mErrors};  // 当前要素
+        std::vector<double> mNumbers; // 当前坐标或 dash 数组中的数值
+
+        void scalar(const YAML::Mark &mark, const std::string &value, bool isNull);
+
+        void beginContainer(const YAML::Mark &mark, bool isMap);
+
+        void endContainer();
+
+        void endFeature(const YAML::Mark &mark);
+
+        /** 记录 features 中不是映射的元素并跳过 */
+        void skipFeature(const YAML::Mark &mark);
+
+        static size_t lineOf(const YAML::Mark &mark) { return static_cast<size_t>(mark.line) + 1; }
+    };
+}
+
+#endif
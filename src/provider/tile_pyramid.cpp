@@ -0,0 +1,263 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "geometry_utils.h"
+#include "render_data_definition.hpp"
+#include "tile_pyramid.h"
+
+namespace {
+    using RenderPlugin::GeoRect;
+    using RenderPlugin::TilePyramid;
+
+    // key layout, high to low: group (10 bits), level (5 bits), Morton code of the tile at that level (2 * MAX_LEVEL bits)
+    constexpr uint32_t LEVEL_SHIFT = 2 * TilePyramid::MAX_LEVEL;
+    constexpr uint32_t GROUP_SHIFT = LEVEL_SHIFT + 5;
+    constexpr uint64_t MORTON_MASK = (uint64_t{1} << LEVEL_SHIFT) - 1;
+
+    // Web 墨卡托瓦片覆盖的纬度范围
+    constexpr double MAX_MERCATOR_LATITUDE = 85.0511287798066;
+
+    // 视野在某一等级上覆盖的瓦片不超过此数时逐个枚举，更深的等级按这些瓦片的子瓦片区间查找
+    constexpr uint64_t MAX_SEARCH_TILES = 4;
+
+    uint64_t makeKey(uint32_t group, uint32_t level, uint64_t morton) {
+        return (uint64_t{group} << GROUP_SHIFT) | (uint64_t{level} << LEVEL_SHIFT) | morton;
+    }
+
+    uint32_t keyGroup(uint64_t key) { return static_cast<uint32_t>(key >> GROUP_SHIFT); }
+
+    uint32_t keyLevel(uint64_t key) { return static_cast<uint32_t>((key >> LEVEL_SHIFT) & 0x1F); }
+
+    uint64_t spreadBits(uint32_t value) {
+        uint64_t x = value;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    }
+
+    uint32_t compactBits(uint64_t x) {
+        x &= 0x5555555555555555ull;
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+        return static_cast<uint32_t>(x);
+    }
+
+    uint64_t morton(uint32_t x, uint32_t y) { return spreadBits(x) | (spreadBits(y) << 1); }
+
+    /** 经纬度矩形在 [0, 1) 瓦片坐标中的范围，y 向南增大 */
+    struct NormalizedRect {
+        double mX0;
+        double mY0;
+        double mX1;
+        double mY1;
+    };
+
+    double normalizedX(double longitude) {
+        return ((std::clamp)(longitude, -180.0, 180.0) + 180.0) / 360.0;
+    }
+
+    double normalizedY(double latitude) {
+        const double radians = (std::clamp)(latitude, -MAX_MERCATOR_LATITUDE, MAX_MERCATOR_LATITUDE) *
+                               std::numbers::pi / 180.0;
+        return (1.0 - std::asinh(std::tan(radians)) / std::numbers::pi) / 2.0;
+    }
+
+    NormalizedRect normalize(const GeoRect &rect) {
+        return {normalizedX(rect.mMinLongitude), normalizedY(rect.mMaxLatitude),
+                normalizedX(rect.mMaxLongitude), normalizedY(rect.mMinLatitude)};
+    }
+
+    uint32_t tileIndex(double normalized, uint32_t level) {
+        const uint32_t last = (uint32_t{1} << level) - 1;
+        const double index = std::floor(normalized * static_cast<double>(uint32_t{1} << level));
+        return index <= 0.0 ? 0 : (std::min)(static_cast<uint32_t>(index), last);
+    }
+
+    /** 某一等级上覆盖矩形的瓦片，闭区间 */
+    struct TileRange {
+        uint32_t mX0;
+        uint32_t mY0;
+        uint32_t mX1;
+        uint32_t mY1;
+
+        [[nodiscard]] uint64_t count() const {
+            return uint64_t{mX1 - mX0 + 1} * uint64_t{mY1 - mY0 + 1};
+        }
+
+        [[nodiscard]] bool contains(uint32_t x, uint32_t y) const {
+            return x >= mX0 && x <= mX1 && y >= mY0 && y <= mY1;
+        }
+    };
+
+    TileRange tileRange(const NormalizedRect &rect, uint32_t level) {
+        return {tileIndex(rect.mX0, level), tileIndex(rect.mY0, level),
+                tileIndex(rect.mX1, level), tileIndex(rect.mY1, level)};
+    }
+
+    constexpr uint32_t UNBOUNDED_CLASS = TilePyramid::ZOOM_CLASSES - 1;
+
+    uint32_t groupOf(uint32_t minClass, uint32_t maxClass) { return minClass * TilePyramid::ZOOM_CLASSES + maxClass; }
+
+    uint32_t featureGroup(uint8_t minZoom, uint8_t maxZoom) {
+        return groupOf((std::min)(uint32_t{minZoom}, UNBOUNDED_CLASS),
+                       maxZoom == 0 ? UNBOUNDED_CLASS : (std::min)(uint32_t{maxZoom}, UNBOUNDED_CLASS));
+    }
+}
+
+namespace RenderPlugin {
+    void TilePyramid::build(std::span<const GeoRect> bounds, std::span<const uint8_t> minZooms,
+                            std::span<const uint8_t> maxZooms) {
+        mTileKeys = Column<uint64_t>();
+        mTileOffsets = Column<uint32_t>();
+        mItems = Column<uint32_t>();
+
+        std::vector<std::pair<uint64_t, uint32_t>> entries;
+        entries.reserve(bounds.size() + bounds.size() / 2);
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            if (bounds[i].empty()) {
+                continue;
+            }
+            const NormalizedRect rect = normalize(bounds[i]);
+            // the deepest level at which the feature covers at most 2 x 2 tiles. The level follows the extent, not
+            // the minimum zoom: at the minimum zoom level most features (zoom 0 by default) would share the single
+            // level 0 tile and be checked for every view, while a large feature with a high minimum zoom would be
+            // copied into thousands of small tiles. The zoom range is pruned by the group instead, and every
+            // feature is in at most four tiles
+            uint32_t level = MAX_LEVEL;
+            TileRange range = tileRange(rect, level);
+            while (level > 0 && (range.mX1 - range.mX0 > 1 || range.mY1 - range.mY0 > 1)) {
+                range = tileRange(rect, --level);
+            }
+            const uint32_t group = featureGroup(minZooms[i], maxZooms[i]);
+            for (uint32_t y = range.mY0; y <= range.mY1; ++y) {
+                for (uint32_t x = range.mX0; x <= range.mX1; ++x) {
+                    entries.emplace_back(makeKey(group, level, morton(x, y)), static_cast<uint32_t>(i));
+                }
+            }
+        }
+        if (entries.empty()) {
+            return;
+        }
+        std::sort(entries.begin(), entries.end());
+
+        mItems.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i == 0 || entries[i].first != entries[i - 1].first) {
+                mTileKeys.push_back(entries[i].first);
+                mTileOffsets.push_back(static_cast<uint32_t>(i));
+            }
+            mItems.push_back(entries[i].second);
+        }
+        mTileOffsets.push_back(static_cast<uint32_t>(entries.size()));
+        mTileKeys.shrinkToFit();
+        mTileOffsets.shrinkToFit();
+    }
+
+    void TilePyramid::query(const GeoRect &rect, int zoom, std::span<const GeoRect> bounds,
+                            std::span<const uint8_t> minZooms, std::span<const uint8_t> maxZooms,
+                            std::vector<uint32_t> &out) const {
+        const size_t outBegin = out.size();
+        if (mTileKeys.empty()) {
+            for (size_t i = 0; i < bounds.size(); ++i) {
+                if (isZoomVisible(zoom, minZooms[i], maxZooms[i]) && geoRectsIntersect(bounds[i], rect)) {
+                    out.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            return;
+        }
+        if (zoom < 0 || rect.empty()) {
+            return;
+        }
+
+        const NormalizedRect normalized = normalize(rect);
+        std::array<TileRange, MAX_LEVEL + 1> ranges{};
+        uint32_t searchLevel = 0;
+        for (uint32_t level = 0; level <= MAX_LEVEL; ++level) {
+            ranges[level] = tileRange(normalized, level);
+            if (ranges[level].count() <= MAX_SEARCH_TILES) {
+                searchLevel = level;
+            }
+        }
+
+        const uint64_t *keys = mTileKeys.begin();
+        const uint64_t *keysEnd = mTileKeys.end();
+        // groups with a minimum zoom above the current one, or a maximum zoom below it, are never visited
+        const uint32_t zoomClass = (std::min)(static_cast<uint32_t>(zoom), MAX_LEVEL);
+        for (uint32_t minClass = 0; minClass <= zoomClass; ++minClass) {
+            const uint64_t *position = std::lower_bound(keys, keysEnd, makeKey(groupOf(minClass, zoomClass), 0, 0));
+            const uint64_t *classEnd = std::lower_bound(position, keysEnd, makeKey(groupOf(minClass + 1, 0), 0, 0));
+            // only the groups and levels actually present are visited
+            while (position != classEnd) {
+                const uint32_t group = keyGroup(*position);
+                const uint32_t level = keyLevel(*position);
+                const uint64_t *levelEnd = std::lower_bound(position, classEnd, makeKey(group, level + 1, 0));
+                const uint32_t coarse = (std::min)(level, searchLevel);
+                const TileRange &coarseRange = ranges[coarse];
+                const TileRange &levelRange = ranges[level];
+                const uint32_t shift = 2 * (level - coarse);
+                for (uint32_t cy = coarseRange.mY0; cy <= coarseRange.mY1; ++cy) {
+                    for (uint32_t cx = coarseRange.mX0; cx <= coarseRange.mX1; ++cx) {
+                        // descendants of a tile are contiguous in Morton order
+                        const uint64_t first = morton(cx, cy) << shift;
+                        const uint64_t last = (morton(cx, cy) + 1) << shift;
+                        const uint64_t *tile = std::lower_bound(position, levelEnd, makeKey(group, level, first));
+                        // the descendants of the last coarse tile end with the level, its end code does not fit
+                        const uint64_t *tileEnd = last > MORTON_MASK
+                                                  ? levelEnd
+                                                  : std::lower_bound(tile, levelEnd, makeKey(group, level, last));
+                        for (; tile != tileEnd; ++tile) {
+                            const uint64_t code = *tile & MORTON_MASK;
+                            if (!levelRange.contains(compactBits(code), compactBits(code >> 1))) {
+                                continue;
+                            }
+                            const auto index = static_cast<size_t>(tile - keys);
+                            for (uint32_t item = mTileOffsets[index]; item < mTileOffsets[index + 1]; ++item) {
+                                const uint32_t feature = mItems[item];
+                                if (geoRectsIntersect(bounds[feature], rect)) {
+                                    out.push_back(feature);
+                                }
+                            }
+                        }
+                    }
+                }
+                position = levelEnd;
+            }
+        }
+        // a feature can be in up to four tiles, and drawing needs the file order
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(outBegin), out.end());
+        out.erase(std::unique(out.begin() + static_cast<std::ptrdiff_t>(outBegin), out.end()), out.end());
+    }
+
+    bool TilePyramid::valid(size_t featureCount) const {
+        if (mTileKeys.empty()) {
+            return mItems.empty() && mTileOffsets.empty();
+        }
+        if (mTileOffsets.size() != mTileKeys.size() + 1 || mTileOffsets[0] != 0 ||
+            mTileOffsets[mTileKeys.size()] != mItems.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < mTileKeys.size(); ++i) {
+            const uint64_t key = mTileKeys[i];
+            const uint32_t level = keyLevel(key);
+            if ((i > 0 && key <= mTileKeys[i - 1]) || keyGroup(key) >= GROUP_COUNT || level > MAX_LEVEL ||
+                (key & MORTON_MASK) >> (2 * level) != 0 || mTileOffsets[i + 1] < mTileOffsets[i]) {
+                return false;
+            }
+        }
+        return std::all_of(mItems.begin(), mItems.end(), [featureCount](uint32_t item) {
+            return item < featureCount;
+        });
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_TILE_PYRAMID_H
+#define RENDERPLUGIN_TILE_PYRAMID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "column.h"
+#include "geometry_definition.hpp"
+
+namespace RenderPlugin {
+    /**
+     * 按缩放区间分组的 z/x/y 瓦片金字塔（Web 墨卡托瓦片，与 zoom 字段同为 log2(360 / 跨度) 的等级），加载结束时构建，之后只读。
+     * 要素先按（最小缩放等级，最大缩放等级）分组，再放入其包围盒在最深一级（每个方向最多跨 2 个瓦片）上覆盖的瓦片中；
+     * 瓦片等级由要素大小决定而不是最小缩放等级，缩放区间由分组筛选，每个要素最多进入 4 个瓦片。
+     * 瓦片按（分组、等级、Morton 码）排序连续存放，子瓦片在 Morton 顺序中连续，
+     * 因此视野内某一等级的全部瓦片是少数几段连续区间。最小缩放等级相同的分组按最大缩放等级连续排列，
+     * 查询时对每个不大于当前缩放等级的最小缩放等级直接定位到最大缩放等级不小于当前等级的一段，
+     * 因缩放区间而隐藏的要素不会被访问。包围盒为空的要素（没有坐标）不进入金字塔。
+     * 所有数据都是平坦数组，可以原样写入二进制数据集并直接指向映射内存。
+     */
+    class TilePyramid {
+    public:
+        /** 最深的瓦片等级，与最大缩放等级一致 */
+        static constexpr uint32_t MAX_LEVEL = 19;
+
+        /** 缩放等级的分类数：0–19 各一类，最后一类为更大的最小缩放等级（永远不会显示）或不限的最大缩放等级 */
+        static constexpr uint32_t ZOOM_CLASSES = MAX_LEVEL + 2;
+
+        /** 分组数，每个（最小缩放等级分类，最大缩放等级分类）一组 */
+        static constexpr uint32_t GROUP_COUNT = ZOOM_CLASSES * ZOOM_CLASSES;
+
+        /** 按各要素的包围盒和缩放区间（最大缩放等级 0 表示不限）重新构建 */
+        void build(std::span<const GeoRect> bounds, std::span<const uint8_t> minZooms,
+                   std::span<const uint8_t> maxZooms);
+
+        /**
+         * 将在缩放等级 zoom 下可见且包围盒与 rect 相交的要素下标按升序（即绘制顺序）追加到 out；
+         * bounds、minZooms、maxZooms 须为构建时的数据。金字塔为空时逐个检查全部要素
+         */
+        void query(const GeoRect &rect, int zoom, std::span<const GeoRect> bounds, std::span<const uint8_t> minZooms,
+                   std::span<const uint8_t> maxZooms, std::vector<uint32_t> &out) const;
+
+        /** 检查瓦片键严格递增且字段有效、偏移单调并覆盖全部子项、子项为有效的要素下标。用于校验从文件映射的数据 */
+        [[nodiscard]] bool valid(size_t featureCount) const;
+
+        [[nodiscard]] bool empty() const { return mTileKeys.empty(); }
+
+        [[nodiscard]] size_t tileCount() const { return mTileKeys.size(); }
+
+    private:
+        friend class FeatureStoreBinary;
+
+        Column<uint64_t> mTileKeys;     // 分组、等级、Morton 码，见 tile_pyramid.cpp
+        Column<uint32_t> mTileOffsets;  // 第 i 个瓦片的要素为 mItems[mTileOffsets[i], mTileOffsets[i + 1])
+        Column<uint32_t> mItems;
+    };
+}
+
+#endif
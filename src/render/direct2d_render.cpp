@@ -17,6 +17,10 @@ namespace RenderPlugin {
                 static_cast<float>(r.bottom)
             );
         }
+
+        inline D2D1_COLOR_F toD2DColor(const Color &c) {
+            return D2D1::ColorF(c.red / 255.0f, c.green / 255.0f, c.blue / 255.0f, c.alpha / 255.0f);
+        }
     }
 
     Direct2DRender::Direct2DRender() {
@@ -26,6 +30,7 @@ namespace RenderPlugin {
     }
 
     Direct2DRender::~Direct2DRender() {
+        releaseBrushes();
         mDCRenderTarget.Reset();
         mDWriteFactory.Reset();
         mD2DFactory.Reset();
@@ -91,10 +96,48 @@ namespace RenderPlugin {
         if (!mDCRenderTarget) return;
         const HRESULT hr = mDCRenderTarget->EndDraw();
         if (hr == D2DERR_RECREATE_TARGET) {
+            releaseBrushes();
             mDCRenderTarget.Reset();
         }
     }
 
+    void Direct2DRender::usePalette(const Palette &palette) {
+        if (palette.id() == mPaletteId) {
+            return;
+        }
+        mPaletteId = palette.id();
+        mColors.clear();
+        mColors.reserve(palette.size());
+        for (const auto &c: palette.colors()) {
+            mColors.push_back(toD2DColor(c));
+        }
+        mBrushes.clear();
+        mBrushes.resize(mColors.size());
+    }
+
+    ID2D1SolidColorBrush *Direct2DRender::brush(PaletteIndex index) {
+        if (mBrushes.empty() || !mDCRenderTarget) {
+            return nullptr;
+        }
+        if (index >= mBrushes.size()) {
+            index = Palette::DEFAULT_INDEX;
+        }
+        auto &cached = mBrushes[index];
+        if (!cached) {
+            if (FAILED(mDCRenderTarget->CreateSolidColorBrush(mColors[index], cached.GetAddressOf()))) {
+                cached.Reset();
+                return nullptr;
+            }
+        }
+        return cached.Get();
+    }
+
+    void Direct2DRender::releaseBrushes() {
+        for (auto &cached: mBrushes) {
+            cached.Reset();
+        }
+    }
+
     bool Direct2DRender::beginFrame(HDC hdc) {
         return SUCCEEDED(begin(hdc));
     }
@@ -103,18 +146,18 @@ namespace RenderPlugin {
         end();
     }
 
-    void Direct2DRender::drawLine(HDC hdc, const std::vector<POINT> &points, const RenderData &data) {
+    void Direct2DRender::drawLine(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) {
         if (points.size() < 2) return;
 
-        const FLOAT strokeWidth = data.mStrokeWidth > 0.0f
-            ? data.mStrokeWidth
-            : (data.mLineStyle == LineStyle::Dashed ? 2.5f : 1.0f);
+        const FLOAT strokeWidth = style.mStrokeWidth > 0.0f
+            ? style.mStrokeWidth
+            : (style.mLineStyle == LineStyle::Dashed ? 2.5f : 1.0f);
 
         Microsoft::WRL::ComPtr<ID2D1StrokeStyle> dashedStyle;
         ID2D1StrokeStyle *strokeStyle = nullptr;
-        if (data.mLineStyle == LineStyle::Dashed && mD2DFactory) {
-            const FLOAT dashLen = data.mDashLength > 0.0f ? data.mDashLength : 10.0f;
-            const FLOAT gapLen = data.mGapLength > 0.0f ? data.mGapLength : 6.0f;
+        if (style.mLineStyle == LineStyle::Dashed && mD2DFactory) {
+            const FLOAT dashLen = style.mDashLength > 0.0f ? style.mDashLength : 10.0f;
+            const FLOAT gapLen = style.mGapLength > 0.0f ? style.mGapLength : 6.0f;
             const D2D1_STROKE_STYLE_PROPERTIES dashProps = D2D1::StrokeStyleProperties(
                 D2D1_CAP_STYLE_FLAT,
                 D2D1_CAP_STYLE_FLAT,
@@ -130,15 +173,14 @@ namespace RenderPlugin {
             }
         }
 
-        Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> brush;
-        if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mColor.d2dColor, brush.GetAddressOf()))) {
+        if (auto *lineBrush = brush(style.mColor)) {
             for (size_t i = 1; i < points.size(); ++i) {
                 const auto &p0 = points[i - 1];
                 const auto &p1 = points[i];
                 mDCRenderTarget->DrawLine(
                     D2D1::Point2F(static_cast<float>(p0.x), static_cast<float>(p0.y)),
                     D2D1::Point2F(static_cast<float>(p1.x), static_cast<float>(p1.y)),
-                    brush.Get(),
+                    lineBrush,
                     strokeWidth,
                     strokeStyle
                 );
@@ -146,7 +188,7 @@ namespace RenderPlugin {
         }
     }
 
-    void Direct2DRender::drawArea(HDC hdc, const std::vector<POINT> &points, const RenderData &data) {
+    void Direct2DRender::drawArea(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) {
         if (points.size() < 3) return;
 
         Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
@@ -176,22 +218,21 @@ namespace RenderPlugin {
         sink->EndFigure(D2D1_FIGURE_END_CLOSED);
         sink->Close();
 
-        Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> fillBrush;
-        if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mFill.d2dColor, fillBrush.GetAddressOf()))) {
-            mDCRenderTarget->FillGeometry(geometry.Get(), fillBrush.Get());
+        if (auto *fillBrush = brush(style.mFill)) {
+            mDCRenderTarget->FillGeometry(geometry.Get(), fillBrush);
         }
 
-        const bool drawOutline = !data.mRawColor.empty() || data.mLineStyle == LineStyle::Dashed;
+        const bool drawOutline = style.mHasColor || style.mLineStyle == LineStyle::Dashed;
         if (drawOutline) {
-            const FLOAT outlineWidth = data.mStrokeWidth > 0.0f
-                ? data.mStrokeWidth
-                : (data.mLineStyle == LineStyle::Dashed ? 2.5f : 1.0f);
+            const FLOAT outlineWidth = style.mStrokeWidth > 0.0f
+                ? style.mStrokeWidth
+                : (style.mLineStyle == LineStyle::Dashed ? 2.5f : 1.0f);
 
             Microsoft::WRL::ComPtr<ID2D1StrokeStyle> outlineDashedStyle;
             ID2D1StrokeStyle *outlineStrokeStyle = nullptr;
-            if (data.mLineStyle == LineStyle::Dashed && mD2DFactory) {
-                const FLOAT dashLen = data.mDashLength > 0.0f ? data.mDashLength : 10.0f;
-                const FLOAT gapLen = data.mGapLength > 0.0f ? data.mGapLength : 6.0f;
+            if (style.mLineStyle == LineStyle::Dashed && mD2DFactory) {
+                const FLOAT dashLen = style.mDashLength > 0.0f ? style.mDashLength : 10.0f;
+                const FLOAT gapLen = style.mGapLength > 0.0f ? style.mGapLength : 6.0f;
                 const D2D1_STROKE_STYLE_PROPERTIES dashProps = D2D1::StrokeStyleProperties(
                     D2D1_CAP_STYLE_FLAT,
                     D2D1_CAP_STYLE_FLAT,
@@ -206,18 +247,17 @@ namespace RenderPlugin {
                     outlineStrokeStyle = outlineDashedStyle.Get();
                 }
             }
-            Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> strokeBrush;
-            if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mColor.d2dColor, strokeBrush.GetAddressOf()))) {
-                mDCRenderTarget->DrawGeometry(geometry.Get(), strokeBrush.Get(), outlineWidth, outlineStrokeStyle);
+            if (auto *strokeBrush = brush(style.mColor)) {
+                mDCRenderTarget->DrawGeometry(geometry.Get(), strokeBrush, outlineWidth, outlineStrokeStyle);
             }
         }
     }
 
-    void Direct2DRender::drawText(HDC hdc, const POINT &pt, const RenderData &data,
+    void Direct2DRender::drawText(HDC hdc, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
                                   float effectiveFontSizePixels) {
-        if (data.mText.empty()) return;
+        if (text.empty()) return;
 
-        const FLOAT baseSize = data.mFontSize > 0 ? static_cast<FLOAT>(data.mFontSize) : 12.0f;
+        const FLOAT baseSize = style.mFontSize > 0 ? static_cast<FLOAT>(style.mFontSize) : 12.0f;
         const FLOAT fontSize = effectiveFontSizePixels > 0.0f ? effectiveFontSizePixels : baseSize;
 
         // 先用左对齐布局测量实际宽高，避免 CENTER/TRAILING 时 GetMetrics 返回整块布局宽
@@ -241,8 +281,8 @@ namespace RenderPlugin {
         constexpr FLOAT maxLayoutSize = 4096.0f;
         Microsoft::WRL::ComPtr<IDWriteTextLayout> measureLayout;
         if (FAILED(mDWriteFactory->CreateTextLayout(
-            data.mText.c_str(),
-            static_cast<UINT32>(data.mText.length()),
+            text.data(),
+            static_cast<UINT32>(text.size()),
             measureFormat.Get(),
             maxLayoutSize,
             maxLayoutSize,
@@ -259,7 +299,7 @@ namespace RenderPlugin {
 
         DWRITE_TEXT_ALIGNMENT hAlign = DWRITE_TEXT_ALIGNMENT_LEADING;
         DWRITE_PARAGRAPH_ALIGNMENT vAlign = DWRITE_PARAGRAPH_ALIGNMENT_NEAR;
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::TopLeft:
             case TextAnchor::MidLeft:
             case TextAnchor::BottomLeft:
@@ -276,7 +316,7 @@ namespace RenderPlugin {
                 hAlign = DWRITE_TEXT_ALIGNMENT_TRAILING;
                 break;
         }
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::TopLeft:
             case TextAnchor::TopCenter:
             case TextAnchor::TopRight:
@@ -316,8 +356,8 @@ namespace RenderPlugin {
         const FLOAT drawLayoutHeight = (contentHeight > 0.0f) ? contentHeight + 1.0f : 1.0f;
         Microsoft::WRL::ComPtr<IDWriteTextLayout> textLayout;
         if (FAILED(mDWriteFactory->CreateTextLayout(
-            data.mText.c_str(),
-            static_cast<UINT32>(data.mText.length()),
+            text.data(),
+            static_cast<UINT32>(text.size()),
             format.Get(),
             drawLayoutWidth,
             drawLayoutHeight,
@@ -328,7 +368,7 @@ namespace RenderPlugin {
 
         FLOAT originX = static_cast<FLOAT>(pt.x);
         FLOAT originY = static_cast<FLOAT>(pt.y);
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::TopCenter:
             case TextAnchor::Center:
             case TextAnchor::BottomCenter:
@@ -342,7 +382,7 @@ namespace RenderPlugin {
             default:
                 break;
         }
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::MidLeft:
             case TextAnchor::Center:
             case TextAnchor::MidRight:
@@ -365,23 +405,20 @@ namespace RenderPlugin {
             originX + contentWidth + textBackgroundPadding,
             originY + contentHeight + textBackgroundPadding
         );
-        if (!data.mRawTextBackground.empty()) {
-            Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> bgBrush;
-            if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mTextBackground.d2dColor, bgBrush.GetAddressOf()))) {
-                mDCRenderTarget->FillRectangle(bgRect, bgBrush.Get());
+        if (style.mHasTextBackground) {
+            if (auto *bgBrush = brush(style.mTextBackground)) {
+                mDCRenderTarget->FillRectangle(bgRect, bgBrush);
             }
         }
-        if (!data.mRawTextBackgroundStroke.empty()) {
-            Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> strokeBrush;
-            const FLOAT strokeW = data.mTextBackgroundStrokeWidth > 0.0f ? data.mTextBackgroundStrokeWidth : 2.0f;
-            if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mTextBackgroundStroke.d2dColor, strokeBrush.GetAddressOf()))) {
-                mDCRenderTarget->DrawRectangle(bgRect, strokeBrush.Get(), strokeW);
+        if (style.mHasTextBackgroundStroke) {
+            const FLOAT strokeW = style.mTextBackgroundStrokeWidth > 0.0f ? style.mTextBackgroundStrokeWidth : 2.0f;
+            if (auto *strokeBrush = brush(style.mTextBackgroundStroke)) {
+                mDCRenderTarget->DrawRectangle(bgRect, strokeBrush, strokeW);
             }
         }
 
-        Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> brush;
-        if (SUCCEEDED(mDCRenderTarget->CreateSolidColorBrush(data.mColor.d2dColor, brush.GetAddressOf()))) {
-            mDCRenderTarget->DrawTextLayout(origin, textLayout.Get(), brush.Get(),
+        if (auto *textBrush = brush(style.mColor)) {
+            mDCRenderTarget->DrawTextLayout(origin, textLayout.Get(), textBrush,
                 D2D1_DRAW_TEXT_OPTIONS_NO_SNAP);
         }
     }
@@ -6,6 +6,7 @@
 
 #include <d2d1.h>
 #include <dwrite.h>
+#include <vector>
 #include <wrl/client.h>
 
 #include "render.h"
@@ -17,11 +18,13 @@ namespace RenderPlugin {
 
         ~Direct2DRender() override;
 
-        void drawLine(HDC hdc, const std::vector<POINT> &points, const RenderData &data) override;
+        void usePalette(const Palette &palette) override;
 
-        void drawArea(HDC hdc, const std::vector<POINT> &points, const RenderData &data) override;
+        void drawLine(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) override;
 
-        void drawText(HDC hdc, const POINT &pt, const RenderData &data,
+        void drawArea(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) override;
+
+        void drawText(HDC hdc, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
                      float effectiveFontSizePixels = 0.0f) override;
 
         bool beginFrame(HDC hdc) override;
@@ -34,6 +37,15 @@ namespace RenderPlugin {
         Microsoft::WRL::ComPtr<IDWriteFactory> mDWriteFactory;
         Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> mDCRenderTarget;
 
+        uint64_t mPaletteId{0};
+        std::vector<D2D1_COLOR_F> mColors;
+        // 每个调色板条目一个画刷，依赖于 mDCRenderTarget，首次使用时创建，渲染目标重建时清空
+        std::vector<Microsoft::WRL::ComPtr<ID2D1SolidColorBrush>> mBrushes;
+
+        ID2D1SolidColorBrush *brush(PaletteIndex index);
+
+        void releaseBrushes();
+
         HRESULT ensureDeviceResources();
         HRESULT begin(HDC hdc);
 
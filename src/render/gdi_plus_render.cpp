@@ -7,30 +7,61 @@
 using namespace Gdiplus;
 
 namespace RenderPlugin {
+    namespace {
+        inline Gdiplus::Color toGdiColor(const RenderPlugin::Color &c) {
+            return Gdiplus::Color(c.alpha, c.red, c.green, c.blue);
+        }
+    }
+
     GDIPlusRender::GDIPlusRender() {
         GdiplusStartup(&mGdiplusToken, &mGdiplusStartupInput, nullptr);
     }
 
     GDIPlusRender::~GDIPlusRender() {
+        // GDI+ 对象必须在 GdiplusShutdown 之前释放
+        mBrushes.clear();
         GdiplusShutdown(mGdiplusToken);
     }
 
-    void GDIPlusRender::drawLine(HDC hdc, const std::vector<POINT> &points, const RenderData &data) {
+    void GDIPlusRender::usePalette(const Palette &palette) {
+        if (palette.id() == mPaletteId) {
+            return;
+        }
+        mPaletteId = palette.id();
+        mColors.clear();
+        mBrushes.clear();
+        mColors.reserve(palette.size());
+        mBrushes.reserve(palette.size());
+        for (const auto &c: palette.colors()) {
+            mColors.push_back(toGdiColor(c));
+            mBrushes.push_back(std::make_unique<SolidBrush>(mColors.back()));
+        }
+    }
+
+    const Gdiplus::Color &GDIPlusRender::color(PaletteIndex index) const {
+        return mColors[index < mColors.size() ? index : Palette::DEFAULT_INDEX];
+    }
+
+    Gdiplus::SolidBrush *GDIPlusRender::brush(PaletteIndex index) const {
+        return mBrushes[index < mBrushes.size() ? index : Palette::DEFAULT_INDEX].get();
+    }
+
+    void GDIPlusRender::drawLine(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) {
         std::vector<Point> point;
-        std::for_each(points.begin(), points.end(), [&point](const POINT &p) {
+        std::for_each(points.begin(), points.end(), [&point](const PixelPoint &p) {
             point.emplace_back(p.x, p.y);
         });
 
         Graphics graphics(hdc);
         graphics.SetSmoothingMode(SmoothingModeAntiAlias);
-        const float penWidth = data.mStrokeWidth > 0.0f
-            ? data.mStrokeWidth
-            : (data.mLineStyle == LineStyle::Dashed ? 2.0f : 1.0f);
-        Pen pen(data.mColor.gdiColor, penWidth);
-        if (data.mLineStyle == LineStyle::Dashed) {
-            if (data.mDashLength > 0.0f && data.mGapLength > 0.0f) {
+        const float penWidth = style.mStrokeWidth > 0.0f
+            ? style.mStrokeWidth
+            : (style.mLineStyle == LineStyle::Dashed ? 2.0f : 1.0f);
+        Pen pen(color(style.mColor), penWidth);
+        if (style.mLineStyle == LineStyle::Dashed) {
+            if (style.mDashLength > 0.0f && style.mGapLength > 0.0f) {
                 const float w = (std::max)(penWidth, 0.1f);
-                REAL dashPattern[] = {data.mDashLength / w, data.mGapLength / w};
+                REAL dashPattern[] = {style.mDashLength / w, style.mGapLength / w};
                 pen.SetDashPattern(dashPattern, 2);
             } else {
                 pen.SetDashStyle(DashStyleDash);
@@ -40,27 +71,26 @@ namespace RenderPlugin {
         graphics.DrawLines(&pen, point.data(), static_cast<int>(point.size()));
     }
 
-    void GDIPlusRender::drawArea(HDC hdc, const std::vector<POINT> &points, const RenderData &data) {
+    void GDIPlusRender::drawArea(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) {
         std::vector<Point> point;
-        std::for_each(points.begin(), points.end(), [&point](const POINT &p) {
+        std::for_each(points.begin(), points.end(), [&point](const PixelPoint &p) {
             point.emplace_back(p.x, p.y);
         });
 
         Graphics graphics(hdc);
         graphics.SetSmoothingMode(SmoothingModeAntiAlias);
-        SolidBrush brush(data.mFill.gdiColor);
-        graphics.FillPolygon(&brush, point.data(), static_cast<int>(point.size()));
+        graphics.FillPolygon(brush(style.mFill), point.data(), static_cast<int>(point.size()));
 
-        const bool drawOutline = !data.mRawColor.empty() || data.mLineStyle == LineStyle::Dashed;
+        const bool drawOutline = style.mHasColor || style.mLineStyle == LineStyle::Dashed;
         if (drawOutline) {
-            const float outlineWidth = data.mStrokeWidth > 0.0f
-                ? data.mStrokeWidth
-                : (data.mLineStyle == LineStyle::Dashed ? 2.0f : 1.0f);
-            Pen outlinePen(data.mColor.gdiColor, outlineWidth);
-            if (data.mLineStyle == LineStyle::Dashed) {
-                if (data.mDashLength > 0.0f && data.mGapLength > 0.0f) {
+            const float outlineWidth = style.mStrokeWidth > 0.0f
+                ? style.mStrokeWidth
+                : (style.mLineStyle == LineStyle::Dashed ? 2.0f : 1.0f);
+            Pen outlinePen(color(style.mColor), outlineWidth);
+            if (style.mLineStyle == LineStyle::Dashed) {
+                if (style.mDashLength > 0.0f && style.mGapLength > 0.0f) {
                     const float w = (std::max)(outlineWidth, 0.1f);
-                    REAL dashPattern[] = {data.mDashLength / w, data.mGapLength / w};
+                    REAL dashPattern[] = {style.mDashLength / w, style.mGapLength / w};
                     outlinePen.SetDashPattern(dashPattern, 2);
                 } else {
                     outlinePen.SetDashStyle(DashStyleDash);
@@ -70,14 +100,13 @@ namespace RenderPlugin {
         }
     }
 
-    void GDIPlusRender::drawText(HDC hdc, const POINT &pt, const RenderData &data,
+    void GDIPlusRender::drawText(HDC hdc, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
                                 float effectiveFontSizePixels) {
-        const float baseSize = data.mFontSize > 0 ? static_cast<float>(data.mFontSize) : 12.0f;
+        const float baseSize = style.mFontSize > 0 ? static_cast<float>(style.mFontSize) : 12.0f;
         const float fontSize = effectiveFontSizePixels > 0.0f ? effectiveFontSizePixels : baseSize;
 
         Graphics graphics(hdc);
         graphics.SetTextRenderingHint(TextRenderingHintAntiAliasGridFit);
-        SolidBrush brush(data.mColor.gdiColor);
         Font font(L"Euroscope", fontSize, FontStyleRegular, UnitPixel);
 
         // 先用左对齐测量实际宽高，避免居中对齐时 MeasureString 返回整块布局宽
@@ -87,11 +116,11 @@ namespace RenderPlugin {
         measureFormat.SetFormatFlags(measureFormat.GetFormatFlags() | StringFormatFlagsNoWrap);
         const RectF measureRect(0.0f, 0.0f, 4096.0f, 4096.0f);
         RectF boundingBox;
-        graphics.MeasureString(data.mText.c_str(), -1, &font, measureRect, &measureFormat, &boundingBox);
+        graphics.MeasureString(text.data(), static_cast<INT>(text.size()), &font, measureRect, &measureFormat, &boundingBox);
 
         StringAlignment hAlign = StringAlignmentNear;
         StringAlignment vAlign = StringAlignmentNear;
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::TopCenter:
             case TextAnchor::Center:
             case TextAnchor::BottomCenter:
@@ -105,7 +134,7 @@ namespace RenderPlugin {
             default:
                 break;
         }
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::MidLeft:
             case TextAnchor::Center:
             case TextAnchor::MidRight:
@@ -126,7 +155,7 @@ namespace RenderPlugin {
 
         float left = static_cast<float>(pt.x);
         float top = static_cast<float>(pt.y);
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::TopCenter:
             case TextAnchor::Center:
             case TextAnchor::BottomCenter:
@@ -140,7 +169,7 @@ namespace RenderPlugin {
             default:
                 break;
         }
-        switch (data.mTextAnchor) {
+        switch (style.mTextAnchor) {
             case TextAnchor::MidLeft:
             case TextAnchor::Center:
             case TextAnchor::MidRight:
@@ -163,16 +192,15 @@ namespace RenderPlugin {
             boundingBox.Width + textBackgroundPadding * 2.0f,
             boundingBox.Height + textBackgroundPadding * 2.0f
         );
-        if (!data.mRawTextBackground.empty()) {
-            SolidBrush bgBrush(data.mTextBackground.gdiColor);
-            graphics.FillRectangle(&bgBrush, bgRect);
+        if (style.mHasTextBackground) {
+            graphics.FillRectangle(brush(style.mTextBackground), bgRect);
         }
-        if (!data.mRawTextBackgroundStroke.empty()) {
-            const float strokeW = data.mTextBackgroundStrokeWidth > 0.0f ? data.mTextBackgroundStrokeWidth : 2.0f;
-            Pen strokePen(data.mTextBackgroundStroke.gdiColor, strokeW);
+        if (style.mHasTextBackgroundStroke) {
+            const float strokeW = style.mTextBackgroundStrokeWidth > 0.0f ? style.mTextBackgroundStrokeWidth : 2.0f;
+            Pen strokePen(color(style.mTextBackgroundStroke), strokeW);
             graphics.DrawRectangle(&strokePen, bgRect);
         }
 
-        graphics.DrawString(data.mText.c_str(), -1, &font, drawRect, &format, &brush);
+        graphics.DrawString(text.data(), static_cast<INT>(text.size()), &font, drawRect, &format, brush(style.mColor));
     }
 }
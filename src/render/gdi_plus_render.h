@@ -4,6 +4,12 @@
 #ifndef RENDERPLUGIN_GDI_PLUS_RENDER_H
 #define RENDERPLUGIN_GDI_PLUS_RENDER_H
 
+#include <windows.h>
+#include <gdiplus.h>
+
+#include <memory>
+#include <vector>
+
 #include "render.h"
 
 namespace RenderPlugin {
@@ -13,16 +19,25 @@ namespace RenderPlugin {
 
         ~GDIPlusRender() override;
 
-        void drawLine(HDC hdc, const std::vector<POINT> &points, const RenderData &data) override;
+        void usePalette(const Palette &palette) override;
+
+        void drawLine(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) override;
 
-        void drawArea(HDC hdc, const std::vector<POINT> &points, const RenderData &data) override;
+        void drawArea(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) override;
 
-        void drawText(HDC hdc, const POINT &pt, const RenderData &data,
+        void drawText(HDC hdc, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
                      float effectiveFontSizePixels = 0.0f) override;
 
     private:
         Gdiplus::GdiplusStartupInput mGdiplusStartupInput;
         ULONG_PTR mGdiplusToken{};
+        uint64_t mPaletteId{0};
+        std::vector<Gdiplus::Color> mColors;
+        std::vector<std::unique_ptr<Gdiplus::SolidBrush>> mBrushes;
+
+        const Gdiplus::Color &color(PaletteIndex index) const;
+
+        Gdiplus::SolidBrush *brush(PaletteIndex index) const;
     };
 }
 
@@ -4,117 +4,124 @@
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <utility>
 
+#include "geometry_utils.h"
 #include "radar_render.h"
 #include "render_data_definition.hpp"
+#include "zoom_utils.h"
 
 namespace {
-
-    bool pointInRect(const POINT &p, const RECT &r) {
-        return p.x >= r.left && p.x <= r.right && p.y >= r.top && p.y <= r.bottom;
+    EuroScopePlugIn::CPosition toPosition(const RenderPlugin::Coordinate &coord) {
+        EuroScopePlugIn::CPosition pos;
+        pos.m_Latitude = coord.mLatitude;
+        pos.m_Longitude = coord.mLongitude;
+        return pos;
     }
 
-    bool segmentsIntersect(const POINT &a, const POINT &b, const POINT &c, const POINT &d) {
-        auto orient = [](const POINT &p, const POINT &q, const POINT &r) {
-            return (q.x - p.x) * (r.y - p.y) - (q.y - p.y) * (r.x - p.x);
-        };
-        long o1 = orient(a, b, c), o2 = orient(a, b, d), o3 = orient(c, d, a), o4 = orient(c, d, b);
-        if (o1 * o2 > 0 || o3 * o4 > 0) {
-            return false;
-        }
-        if (o1 == 0 && o2 == 0) {
-            return (std::min)(a.x, b.x) <= (std::max)(c.x, d.x) && (std::max)(a.x, b.x) >= (std::min)(c.x, d.x) &&
-                   (std::min)(a.y, b.y) <= (std::max)(c.y, d.y) && (std::max)(a.y, b.y) >= (std::min)(c.y, d.y);
-        }
-        return true;
+    RenderPlugin::PixelRect toPixelRect(const RECT &r) {
+        return {static_cast<int32_t>(r.left), static_cast<int32_t>(r.top),
+                static_cast<int32_t>(r.right), static_cast<int32_t>(r.bottom)};
     }
 
-    bool segmentIntersectsRect(const POINT &a, const POINT &b, const RECT &r) {
-        if (pointInRect(a, r) || pointInRect(b, r)) {
-            return true;
+    /** 各类要素绘制所需的最少坐标点数：线段 2 个，区域 3 个，文字 1 个 */
+    size_t minimumPointCount(RenderPlugin::RenderType type) {
+        switch (type) {
+            case RenderPlugin::RenderType::LINE:
+                return 2;
+            case RenderPlugin::RenderType::AREA:
+                return 3;
+            default:
+                return 1;
         }
-        POINT tl = {r.left, r.top};
-        POINT tr = {r.right, r.top};
-        POINT br = {r.right, r.bottom};
-        POINT bl = {r.left, r.bottom};
-        return segmentsIntersect(a, b, tl, tr) || segmentsIntersect(a, b, tr, br) ||
-               segmentsIntersect(a, b, br, bl) || segmentsIntersect(a, b, bl, tl);
     }
 
-    bool pointInPolygon(const POINT &p, const std::vector<POINT> &pts) {
-        if (pts.size() < 3) {
-            return false;
-        }
-        int n = static_cast<int>(pts.size());
-        int crossings = 0;
-        for (int i = 0, j = n - 1; i < n; j = i++) {
-            const auto &vi = pts[i];
-            const auto &vj = pts[j];
-            if ((vi.y > p.y) == (vj.y > p.y)) {
-                continue;
-            }
-            double tx = (p.y - vj.y) * (vi.x - vj.x) / (vi.y - vj.y) + vj.x;
-            if (static_cast<double>(p.x) < tx) {
-                ++crossings;
-            }
-        }
-        return (crossings % 2) == 1;
-    }
+    // 裁剪区经纬度范围每侧至少放宽的像素数，覆盖像素与经纬度互相换算的取整误差
+    constexpr double CLIP_RECT_MARGIN_PIXELS = 2.0;
 } // namespace
 
 namespace RenderPlugin {
     RadarRender::RadarRender(std::shared_ptr<Logger> logger, ProviderPtr dataProvider, RenderPtr render,
                              OnClosedCallback onClosed, int textSizeReferenceZoom)
-            : mDataProvider(std::move(dataProvider)), mRender(std::move(render)), mLogger(std::move(logger)),
-              mOnClosedCallback(std::move(onClosed)), mTextSizeReferenceZoom((std::clamp)(textSizeReferenceZoom, 1, 19)) {}
+            : mDataProvider(std::move(dataProvider)), mSnapshotReader(mDataProvider->createSnapshotReader()),
+              mRender(std::move(render)), mLogger(std::move(logger)), mOnClosedCallback(std::move(onClosed)),
+              mTextSizeReferenceZoom((std::clamp)(textSizeReferenceZoom, 1, 19)) {}
 
     RadarRender::~RadarRender() = default;
 
     void RadarRender::OnRefresh(HDC hDC, int Phase) {
-        if (!mDataProvider->isLoaded() || Phase != EuroScopePlugIn::REFRESH_PHASE_BACK_BITMAP) {
+        if (Phase != EuroScopePlugIn::REFRESH_PHASE_BACK_BITMAP) {
             return;
         }
 
-        auto renderData = mDataProvider->getRenderData();
-        if (!renderData) {
+        // 固定本帧使用的数据集，重新加载发布的新数据集从下一帧开始生效，旧数据集在本帧结束后才可能释放
+        const auto snapshot = mSnapshotReader.pin();
+        // 数据集在后台加载完成前不绘制，发布后插件会请求 RefreshMapContent
+        if (!snapshot) {
             return;
         }
+        const FeatureStore &store = *snapshot;
 
         const int currentZoom = getCurrentZoomLevel();
         const double currentSpanDeg = getCurrentSpanDeg();
 
-        RECT clipRect{};
-        if (GetClipBox(hDC, &clipRect) == ERROR) {
-            clipRect = {0, 0, 4096, 4096};
+        RECT clipBox{};
+        if (GetClipBox(hDC, &clipBox) == ERROR) {
+            clipBox = {0, 0, 4096, 4096};
         }
+        const PixelRect clipRect = toPixelRect(clipBox);
+        const GeoClipRects clipRects = getClipGeoRects(clipBox);
 
         if (!mRender->beginFrame(hDC)) {
             return;
         }
-        for (const auto &data: *renderData) {
-            // 当当前缩放等级小于要素配置的 mZoom 时，不绘制该要素
-            if (currentZoom < data.mZoom) {
+        mRender->usePalette(store.palette());
+        // 当前缩放等级不在要素配置的 zoom–maxZoom 区间内的要素，以及包围盒与裁剪区不相交（不可能有顶点落在屏幕内）的要素，
+        // 都由瓦片金字塔排除，不逐个检查
+        mCandidates.clear();
+        store.queryFeatures(clipRects[0], currentZoom, mCandidates);
+        if (!clipRects[1].empty()) {
+            // 跨越 180° 经线时两侧分别查询，合并为绘制顺序；包围盒跨越经线的要素可能在两侧都出现
+            // 要素编号即配置文件中的顺序，也就是绘制顺序（后写的要素画在上层），两次查询的结果各自有序，
+            // 按编号归并即可恢复绘制顺序。按缩放区间分组只存在于瓦片金字塔的键中，要素数据本身绝不能按缩放等级排序，
+            // 否则区域与线段的上下层关系会被打乱
+            const auto middle = static_cast<std::ptrdiff_t>(mCandidates.size());
+            store.queryFeatures(clipRects[1], currentZoom, mCandidates);
+            std::inplace_merge(mCandidates.begin(), mCandidates.begin() + middle, mCandidates.end());
+            mCandidates.erase(std::unique(mCandidates.begin(), mCandidates.end()), mCandidates.end());
+        }
+        for (const FeatureStore::FeatureIndex i: mCandidates) {
+            const RenderType type = store.type(i);
+            const auto coordinates = store.coordinates(i);
+            if (coordinates.size() < minimumPointCount(type) || (type == RenderType::TEXT && store.text(i).empty())) {
                 continue;
             }
-            // 线段/文字：至少有一个点在屏幕内才渲染；区域：多边形与屏幕相交即渲染（顶点可在屏幕外）
-            bool visible = (data.mType == RenderType::AREA)
-                                  ? isAreaIntersectingClip(data, clipRect)
-                                  : isAnyPointInClip(data, clipRect);
-            if (!visible) {
+            // 线段/文字没有顶点在裁剪区的经纬度范围内时不可能有顶点在屏幕内，投影前排除
+            if (type != RenderType::AREA && !isAnyPointInGeoClip(coordinates, clipRects)) {
                 continue;
             }
-            switch (data.mType) {
+            // 每个顶点每帧只投影一次，屏幕内的判断和绘制共用同一份投影结果
+            project(coordinates, mPoints);
+            switch (type) {
                 case RenderType::LINE:
-                    drawLine(hDC, data);
+                    // 至少有一个点在屏幕内才渲染
+                    if (isAnyPointInRect(mPoints, clipRect)) {
+                        mRender->drawLine(hDC, mPoints, store.style(i));
+                    }
                     break;
                 case RenderType::AREA:
-                    drawArea(hDC, data);
+                    // 多边形与屏幕相交即渲染（顶点可在屏幕外）
+                    if (isPolygonIntersectingRect(mPoints, clipRect)) {
+                        mRender->drawArea(hDC, mPoints, store.style(i));
+                    }
                     break;
                 case RenderType::TEXT:
-                    drawText(hDC, data, currentSpanDeg);
+                    if (isAnyPointInRect(mPoints, clipRect)) {
+                        drawText(hDC, mPoints[0], store.text(i), store.style(i), currentSpanDeg);
+                    }
                     break;
             }
         }
@@ -126,56 +133,58 @@ namespace RenderPlugin {
         EuroScopePlugIn::CPosition rightUp{};
         GetDisplayArea(&leftDown, &rightUp);
 
-        const double spanLon = rightUp.m_Longitude - leftDown.m_Longitude;
-        const double spanLat = rightUp.m_Latitude - leftDown.m_Latitude;
-        const double spanDeg = (std::max)(std::abs(spanLon), std::abs(spanLat));
-
-        if (spanDeg <= std::numeric_limits<double>::epsilon()) {
-            return 19;
-        }
-
-        // 标准地图缩放 1–19：zoom ≈ log2(360 / spanDeg)
-        const double rawZoom = std::log2(360.0 / spanDeg);
-        int zoom = static_cast<int>(std::round(rawZoom));
-        return (std::clamp)(zoom, 1, 19);
+        return spanDegToZoomLevel(getSpanDeg(leftDown.m_Longitude, leftDown.m_Latitude,
+                                             rightUp.m_Longitude, rightUp.m_Latitude));
     }
 
-    bool RadarRender::isAnyPointInClip(const RenderData &data, const RECT &clipRect) {
-        if (data.mCoordinates.empty()) {
-            return false;
-        }
-        for (const auto &coord: data.mCoordinates) {
-            POINT pt = ConvertCoordFromPositionToPixel(coord.toPosition());
-            if (pt.x >= clipRect.left && pt.x <= clipRect.right &&
-                pt.y >= clipRect.top && pt.y <= clipRect.bottom) {
-                return true;
-            }
-        }
-        return false;
+    GeoClipRects RadarRender::getClipGeoRects(const RECT &clipBox) {
+        const LONG midX = clipBox.left + (clipBox.right - clipBox.left) / 2;
+        const LONG midY = clipBox.top + (clipBox.bottom - clipBox.top) / 2;
+        // 裁剪区的四角和四边中点（按边交替排列，每条边为 角-中点-角），经度以中心为准展开，跨越 180° 经线时仍然连续
+        const POINT samples[] = {
+                {clipBox.left, clipBox.top}, {midX, clipBox.top}, {clipBox.right, clipBox.top},
+                {clipBox.right, midY}, {clipBox.right, clipBox.bottom}, {midX, clipBox.bottom},
+                {clipBox.left, clipBox.bottom}, {clipBox.left, midY}
+        };
+        constexpr size_t SAMPLE_COUNT = std::size(samples);
+        const double reference = ConvertCoordFromPixelToPosition({midX, midY}).m_Longitude;
+        Coordinate positions[SAMPLE_COUNT];
+        GeoRect rect;
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+            const EuroScopePlugIn::CPosition position = ConvertCoordFromPixelToPosition(samples[i]);
+            positions[i] = {unwrapLongitude(position.m_Longitude, reference), position.m_Latitude};
+            rect.expand(positions[i].mLongitude, positions[i].mLatitude);
+        }
+
+        // 一个像素对应的经纬度跨度
+        const double pixelWidth = (std::max)(static_cast<double>(clipBox.right - clipBox.left), 1.0);
+        const double pixelHeight = (std::max)(static_cast<double>(clipBox.bottom - clipBox.top), 1.0);
+        double lonMargin = (rect.mMaxLongitude - rect.mMinLongitude) / pixelWidth * CLIP_RECT_MARGIN_PIXELS;
+        double latMargin = (rect.mMaxLatitude - rect.mMinLatitude) / pixelHeight * CLIP_RECT_MARGIN_PIXELS;
+        // 投影变形使屏幕边缘在经纬度中弯曲：边的中点偏离两角连线中点的距离即弯曲程度，
+        // 采样点之间的边不会超出采样点所围范围超过这个距离
+        for (size_t corner = 0; corner < SAMPLE_COUNT; corner += 2) {
+            const Coordinate &from = positions[corner];
+            const Coordinate &middle = positions[corner + 1];
+            const Coordinate &to = positions[(corner + 2) % SAMPLE_COUNT];
+            lonMargin = (std::max)(lonMargin, std::abs(middle.mLongitude - (from.mLongitude + to.mLongitude) / 2.0));
+            latMargin = (std::max)(latMargin, std::abs(middle.mLatitude - (from.mLatitude + to.mLatitude) / 2.0));
+        }
+        rect.mMinLongitude -= lonMargin;
+        rect.mMaxLongitude += lonMargin;
+        rect.mMinLatitude = (std::max)(rect.mMinLatitude - latMargin, -90.0);
+        rect.mMaxLatitude = (std::min)(rect.mMaxLatitude + latMargin, 90.0);
+        return splitAtAntimeridian(rect);
     }
 
-    bool RadarRender::isAreaIntersectingClip(const RenderData &data, const RECT &clipRect) {
-        if (data.mCoordinates.size() < 3) {
-            return false;
-        }
-        std::vector<POINT> points;
-        points.reserve(data.mCoordinates.size());
-        for (const auto &coord : data.mCoordinates) {
-            POINT pt = ConvertCoordFromPositionToPixel(coord.toPosition());
-            points.push_back(pt);
-        }
-        for (const auto &pt : points) {
-            if (pointInRect(pt, clipRect)) {
+    bool RadarRender::isAnyPointInGeoClip(CoordinateView coordinates, const GeoClipRects &clipRects) {
+        for (const auto &coord: coordinates) {
+            if (geoPointInRect(coord.mLongitude, coord.mLatitude, clipRects[0]) ||
+                geoPointInRect(coord.mLongitude, coord.mLatitude, clipRects[1])) {
                 return true;
             }
         }
-        for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
-            if (segmentIntersectsRect(points[j], points[i], clipRect)) {
-                return true;
-            }
-        }
-        POINT center = {(clipRect.left + clipRect.right) / 2, (clipRect.top + clipRect.bottom) / 2};
-        return pointInPolygon(center, points);
+        return false;
     }
 
     double RadarRender::getCurrentSpanDeg() {
@@ -183,54 +192,32 @@ namespace RenderPlugin {
         EuroScopePlugIn::CPosition rightUp{};
         GetDisplayArea(&leftDown, &rightUp);
 
-        const double spanLon = rightUp.m_Longitude - leftDown.m_Longitude;
-        const double spanLat = rightUp.m_Latitude - leftDown.m_Latitude;
-        double spanDeg = (std::max)(std::abs(spanLon), std::abs(spanLat));
+        double spanDeg = getSpanDeg(leftDown.m_Longitude, leftDown.m_Latitude,
+                                    rightUp.m_Longitude, rightUp.m_Latitude);
         if (spanDeg <= std::numeric_limits<double>::epsilon()) {
             spanDeg = 360.0 / 1024.0;
         }
         return spanDeg;
     }
 
-    void RadarRender::drawLine(HDC hDC, const RenderData &data) {
-        if (data.mCoordinates.size() < 2) {
-            return;
-        }
-
-        std::vector<POINT> points;
-        for (const auto &coord: data.mCoordinates) {
-            POINT pt = ConvertCoordFromPositionToPixel(coord.toPosition());
-            points.push_back(pt);
-        }
-
-        mRender->drawLine(hDC, points, data);
+    void RadarRender::drawText(HDC hDC, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
+                               double /* spanDeg */) {
+        // 文字大小固定为配置的 size（像素），不随视野缩放
+        const float effectiveFontSize = style.mFontSize > 0 ? static_cast<float>(style.mFontSize) : 12.0f;
+        mRender->drawText(hDC, pt, text, style, effectiveFontSize);
     }
 
-    void RadarRender::drawArea(HDC hDC, const RenderData &data) {
-        if (data.mCoordinates.size() < 3) {
-            return;
-        }
-
-        std::vector<POINT> points;
-        for (const auto &coord: data.mCoordinates) {
-            POINT pt = ConvertCoordFromPositionToPixel(coord.toPosition());
-            points.push_back(pt);
-        }
-
-        mRender->drawArea(hDC, points, data);
+    PixelPoint RadarRender::project(const Coordinate &coord) {
+        const POINT pt = ConvertCoordFromPositionToPixel(toPosition(coord));
+        return {static_cast<int32_t>(pt.x), static_cast<int32_t>(pt.y)};
     }
 
-    void RadarRender::drawText(HDC hDC, const RenderData &data, double /* spanDeg */) {
-        if (data.mCoordinates.empty() || data.mText.empty()) {
-            return;
+    void RadarRender::project(CoordinateView coordinates, std::vector<PixelPoint> &points) {
+        points.clear();
+        points.reserve(coordinates.size());
+        for (const auto &coord: coordinates) {
+            points.push_back(project(coord));
         }
-
-        const auto &coord = data.mCoordinates[0];
-        POINT pt = ConvertCoordFromPositionToPixel(coord.toPosition());
-
-        // 文字大小固定为配置的 size（像素），不随视野缩放
-        const float effectiveFontSize = data.mFontSize > 0 ? static_cast<float>(data.mFontSize) : 12.0f;
-        mRender->drawText(hDC, pt, data, effectiveFontSize);
     }
 
     void RadarRender::OnAsrContentToBeClosed() {
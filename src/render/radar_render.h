@@ -6,8 +6,12 @@
 
 #include <functional>
 #include <memory>
+#include <string_view>
+#include <vector>
 #include <windows.h>
 
+#include "EuroScopePlugIn.h"
+#include "geometry_definition.hpp"
 #include "logger.h"
 #include "render.h"
 #include "render_data_provider.h"
@@ -30,26 +34,35 @@ namespace RenderPlugin {
         /** 当前视野的经纬度跨度（度），用于连续缩放文字等 */
         double getCurrentSpanDeg();
 
-        /** 判断要素是否至少有一个坐标点在裁剪区内（屏幕内），用于线段和文字 */
-        bool isAnyPointInClip(const RenderData &data, const RECT &clipRect);
+        /**
+         * 裁剪区（GetClipBox）对应的经纬度范围，由 ConvertCoordFromPixelToPosition 换算边界上的采样点并四周留出余量，
+         * 每帧计算一次，用于在投影前剔除要素；跨越 180° 经线时为经线两侧的两个矩形
+         */
+        GeoClipRects getClipGeoRects(const RECT &clipBox);
 
-        /** 判断多边形区域是否与裁剪区相交（顶点可在屏幕外，区域经过屏幕即返回 true），用于区域 */
-        bool isAreaIntersectingClip(const RenderData &data, const RECT &clipRect);
+        /** 判断要素是否至少有一个坐标点在裁剪区的经纬度范围内，不做投影，用于线段和文字的粗剔除 */
+        static bool isAnyPointInGeoClip(CoordinateView coordinates, const GeoClipRects &clipRects);
 
         void setOnClosedCallback(OnClosedCallback callback) { mOnClosedCallback = std::move(callback); }
 
     private:
         ProviderPtr mDataProvider;
+        FeatureSnapshots::Reader mSnapshotReader; // declared after mDataProvider, released before it
         RenderPtr mRender;
         std::shared_ptr<Logger> mLogger;
         OnClosedCallback mOnClosedCallback;
         int mTextSizeReferenceZoom{12}; // 文字 size 参考缩放等级（1–19），该 zoom 下 size 即参考像素
+        std::vector<FeatureStore::FeatureIndex> mCandidates; // 每帧视野内的候选要素，复用以免每帧分配
+        std::vector<PixelPoint> mPoints; // 当前要素投影后的顶点，供屏幕内判断和绘制共用，复用以免每个要素分配
 
-        void drawLine(HDC hDC, const RenderData &data);
+        /** 经纬度坐标转换为屏幕像素坐标 */
+        PixelPoint project(const Coordinate &coord);
 
-        void drawArea(HDC hDC, const RenderData &data);
+        /** 将要素的全部坐标依次投影到 points（先清空，保留容量） */
+        void project(CoordinateView coordinates, std::vector<PixelPoint> &points);
 
-        void drawText(HDC hDC, const RenderData &data, double spanDeg);
+        void drawText(HDC hDC, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
+                      double spanDeg);
     };
 }
 
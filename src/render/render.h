@@ -5,7 +5,12 @@
 #define RENDERPLUGIN_RENDER_H
 
 #include <memory>
-#include <render_data_definition.hpp>
+#include <string_view>
+#include <vector>
+#include <windows.h>
+
+#include "feature_store.h"
+#include "geometry_definition.hpp"
 
 namespace RenderPlugin {
     class Render {
@@ -20,12 +25,18 @@ namespace RenderPlugin {
         /** 结束一帧绘制（可选）。Direct2D 在此 EndDraw。 */
         virtual void endFrame() {}
 
-        virtual void drawLine(HDC hdc, const std::vector<POINT> &points, const RenderData &data) = 0;
+        /**
+         * 切换到数据集的调色板，每帧在 beginFrame 之后调用。
+         * 后端据此建立自己的颜色表（及每个调色板条目一个画刷的缓存），调色板 id 未变化时直接返回。
+         */
+        virtual void usePalette(const Palette &palette) = 0;
+
+        virtual void drawLine(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) = 0;
 
-        virtual void drawArea(HDC hdc, const std::vector<POINT> &points, const RenderData &data) = 0;
+        virtual void drawArea(HDC hdc, const std::vector<PixelPoint> &points, const FeatureStyle &style) = 0;
 
-        // effectiveFontSizePixels: 按缩放换算后的字体大小（像素），<=0 时使用 data.mFontSize
-        virtual void drawText(HDC hdc, const POINT &pt, const RenderData &data,
+        // effectiveFontSizePixels: 按缩放换算后的字体大小（像素），<=0 时使用 style.mFontSize
+        virtual void drawText(HDC hdc, const PixelPoint &pt, std::wstring_view text, const FeatureStyle &style,
                              float effectiveFontSizePixels = 0.0f) = 0;
     };
 
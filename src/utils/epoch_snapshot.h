@@ -0,0 +1,193 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_EPOCH_SNAPSHOT_H
+#define RENDERPLUGIN_EPOCH_SNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace RenderPlugin {
+    /**
+     * 按纪元（epoch）发布的只读快照。
+     * 读取方不加锁、不增减引用计数：只在自己的槽位中登记当前纪元后读取快照指针；
+     * 发布方替换快照并推进纪元，旧快照在所有读取方都离开其纪元后才释放。
+     * 发布、回收和读取方的注册在同一把锁下进行，读取本身不涉及锁
+     */
+    template<typename T>
+    class EpochSnapshots {
+        struct Slot;
+
+    public:
+        using Ptr = std::shared_ptr<const T>;
+
+        class Reader;
+
+        /** 读取期间固定当前快照，析构时离开纪元；快照为空时转换为 false */
+        class Pin {
+        public:
+            Pin(const Pin &) = delete;
+
+            Pin &operator=(const Pin &) = delete;
+
+            ~Pin() {
+                if (mSlot != nullptr) {
+                    mSlot->store(IDLE, std::memory_order_release);
+                }
+            }
+
+            [[nodiscard]] const T *get() const { return mSnapshot; }
+
+            const T &operator*() const { return *mSnapshot; }
+
+            const T *operator->() const { return mSnapshot; }
+
+            explicit operator bool() const { return mSnapshot != nullptr; }
+
+        private:
+            friend class Reader;
+
+            Pin(std::atomic<uint64_t> *slot, const T *snapshot) : mSlot(slot), mSnapshot(snapshot) {}
+
+            std::atomic<uint64_t> *mSlot;
+            const T *mSnapshot;
+        };
+
+        /** 读取方（如一个雷达屏幕）的登记，须在 EpochSnapshots 之前销毁；同一读取方同一时刻只能持有一个 Pin */
+        class Reader {
+        public:
+            Reader() = default;
+
+            Reader(Reader &&other) noexcept : mOwner(std::exchange(other.mOwner, nullptr)),
+                                              mSlot(std::exchange(other.mSlot, nullptr)) {}
+
+            Reader &operator=(Reader &&other) noexcept {
+                if (this != &other) {
+                    release();
+                    mOwner = std::exchange(other.mOwner, nullptr);
+                    mSlot = std::exchange(other.mSlot, nullptr);
+                }
+                return *this;
+            }
+
+            ~Reader() { release(); }
+
+            [[nodiscard]] Pin pin() const {
+                if (mOwner == nullptr) {
+                    return {nullptr, nullptr};
+                }
+                // announce the epoch before reading the pointer, a publisher that retires the snapshot after
+                // this store sees the announcement; both sides are sequentially consistent for that reason
+                mSlot->mEpoch.store(mOwner->mEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+                return {&mSlot->mEpoch, mOwner->mCurrent.load(std::memory_order_seq_cst)};
+            }
+
+        private:
+            friend class EpochSnapshots;
+
+            Reader(EpochSnapshots *owner, Slot *slot) : mOwner(owner), mSlot(slot) {}
+
+            void release() {
+                if (mOwner != nullptr) {
+                    mOwner->releaseSlot(mSlot);
+                    mOwner = nullptr;
+                    mSlot = nullptr;
+                }
+            }
+
+            EpochSnapshots *mOwner{nullptr};
+            Slot *mSlot{nullptr};
+        };
+
+        EpochSnapshots() = default;
+
+        EpochSnapshots(const EpochSnapshots &) = delete;
+
+        EpochSnapshots &operator=(const EpochSnapshots &) = delete;
+
+        [[nodiscard]] Reader createReader() {
+            std::lock_guard lock(mMutex);
+            auto it = std::find_if(mSlots.begin(), mSlots.end(), [](const Slot &slot) { return !slot.mInUse; });
+            if (it == mSlots.end()) {
+                it = mSlots.emplace(mSlots.end());
+            }
+            it->mInUse = true;
+            return {this, &*it};
+        }
+
+        /** 发布新快照（可为空），之后开始的读取看到新快照，旧快照进入待回收列表 */
+        void publish(Ptr snapshot) {
+            std::lock_guard lock(mMutex);
+            const T *raw = snapshot.get();
+            Ptr previous = std::exchange(mOwned, std::move(snapshot));
+            mCurrent.store(raw, std::memory_order_seq_cst);
+            const uint64_t epoch = mEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+            if (previous != nullptr) {
+                mRetired.push_back({std::move(previous), epoch});
+            }
+            collectLocked();
+        }
+
+        /** 释放已没有读取方可能看到的旧快照，由发布方定期调用 */
+        void collect() {
+            std::lock_guard lock(mMutex);
+            collectLocked();
+        }
+
+        /** 当前快照的所有权，供发布方之外的非渲染用途（如增量重新加载）使用 */
+        [[nodiscard]] Ptr current() const {
+            std::lock_guard lock(mMutex);
+            return mOwned;
+        }
+
+        /** 等待回收的旧快照数 */
+        [[nodiscard]] size_t retiredCount() const {
+            std::lock_guard lock(mMutex);
+            return mRetired.size();
+        }
+
+    private:
+        static constexpr uint64_t IDLE = (std::numeric_limits<uint64_t>::max)();
+
+        struct Slot {
+            std::atomic<uint64_t> mEpoch{IDLE};
+            bool mInUse{false};     // guarded by mMutex
+        };
+
+        struct Retired {
+            Ptr mSnapshot;
+            uint64_t mEpoch;        // first epoch in which the snapshot is no longer current
+        };
+
+        mutable std::mutex mMutex;
+        std::atomic<const T *> mCurrent{nullptr};
+        std::atomic<uint64_t> mEpoch{0};
+        Ptr mOwned;
+        std::list<Slot> mSlots;     // node based, readers keep pointers to their slot
+        std::vector<Retired> mRetired;
+
+        void releaseSlot(Slot *slot) {
+            std::lock_guard lock(mMutex);
+            slot->mEpoch.store(IDLE, std::memory_order_release);
+            slot->mInUse = false;
+        }
+
+        void collectLocked() {
+            uint64_t oldest = IDLE;
+            for (const Slot &slot: mSlots) {
+                oldest = (std::min)(oldest, slot.mEpoch.load(std::memory_order_seq_cst));
+            }
+            // a reader pinned before the retiring epoch may still use the snapshot
+            std::erase_if(mRetired, [oldest](const Retired &retired) { return retired.mEpoch <= oldest; });
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <system_error>
+
+#include "file_watcher.h"
+#include "hash_utils.h"
+#include "mapped_file.h"
+
+namespace RenderPlugin {
+    WatchedFile WatchedFile::stat(const fs::path &path, uint64_t contentHash) {
+        WatchedFile file;
+        file.mPath = path;
+        file.mContentHash = contentHash;
+        std::error_code ec;
+        const auto writeTime = fs::last_write_time(path, ec);
+        if (ec) {
+            return file;
+        }
+        const auto size = fs::file_size(path, ec);
+        if (ec) {
+            return file;
+        }
+        file.mWriteTime = writeTime;
+        file.mSize = size;
+        file.mExists = true;
+        return file;
+    }
+
+    bool contentChanged(const std::vector<WatchedFile> &files) {
+        for (const auto &recorded: files) {
+            if (!recorded.mExists) {
+                return true;
+            }
+            auto file = MappedFile::open(recorded.mPath);
+            if (!file || hashBytes(file->view()) != recorded.mContentHash) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    FileWatcher::FileWatcher(Clock::duration quietPeriod) : mQuietPeriod(quietPeriod) {}
+
+    void FileWatcher::watch(std::vector<WatchedFile> files) {
+        mFiles = std::move(files);
+        mObserved = mFiles;
+        mChangePending = false;
+    }
+
+    void FileWatcher::clear() {
+        mFiles.clear();
+        mObserved.clear();
+        mChangePending = false;
+    }
+
+    bool FileWatcher::poll(Clock::time_point now) {
+        bool stampChanged = false;
+        for (auto &observed: mObserved) {
+            WatchedFile current = WatchedFile::stat(observed.mPath, observed.mContentHash);
+            if (!current.sameStamp(observed)) {
+                observed = std::move(current);
+                stampChanged = true;
+            }
+        }
+        if (stampChanged) {
+            mLastChange = now;
+            mChangePending = true;
+            return false;
+        }
+        if (!mChangePending || now - mLastChange < mQuietPeriod) {
+            return false;
+        }
+
+        // a file that is missing is usually in the middle of an atomic save, keep waiting for it
+        for (const auto &observed: mObserved) {
+            if (!observed.mExists) {
+                return false;
+            }
+        }
+        mChangePending = false;
+        mFiles = mObserved;
+        return true;
+    }
+}
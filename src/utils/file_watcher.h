@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_FILE_WATCHER_H
+#define RENDERPLUGIN_FILE_WATCHER_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace RenderPlugin {
+    namespace fs = std::filesystem;
+
+    /** 被监视文件的状态：修改时间、大小和内容哈希 */
+    struct WatchedFile {
+        fs::path mPath;
+        fs::file_time_type mWriteTime{};
+        uintmax_t mSize{0};
+        uint64_t mContentHash{0};
+        bool mExists{false};
+
+        /** 读取文件当前的修改时间和大小，内容哈希由调用方给出 */
+        static WatchedFile stat(const fs::path &path, uint64_t contentHash = 0);
+
+        [[nodiscard]] bool sameStamp(const WatchedFile &other) const {
+            return mExists == other.mExists && mWriteTime == other.mWriteTime && mSize == other.mSize;
+        }
+    };
+
+    /**
+     * 读取文件并与记录的内容哈希比较，任一文件不存在、无法读取或内容不同时返回 true；
+     * 需要读取整个文件，应在后台线程调用
+     */
+    bool contentChanged(const std::vector<WatchedFile> &files);
+
+    /**
+     * 轮询式文件监视，适合在定时器中调用：每次只比较修改时间和大小，不读取文件内容。
+     * 发现变化后等待文件保持不变 quietPeriod（编辑器一次保存常常连续写入多次）再报告一次；
+     * 内容是否确实变化由调用方在后台用 contentChanged 判断。
+     */
+    class FileWatcher {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FileWatcher(Clock::duration quietPeriod);
+
+        /** 以给定状态为基准开始监视，替换之前的文件列表 */
+        void watch(std::vector<WatchedFile> files);
+
+        void clear();
+
+        [[nodiscard]] bool empty() const { return mFiles.empty(); }
+
+        /**
+         * 文件修改时间或大小变化且已静默 quietPeriod 时返回 true，基准随之更新为当前状态；
+         * 基准中的内容哈希保持为上次记录的值
+         */
+        bool poll(Clock::time_point now);
+
+        /** 当前基准状态 */
+        [[nodiscard]] const std::vector<WatchedFile> &files() const { return mFiles; }
+
+    private:
+        Clock::duration mQuietPeriod;
+        std::vector<WatchedFile> mFiles;    // 基准状态
+        std::vector<WatchedFile> mObserved; // 最近一次轮询看到的状态
+        Clock::time_point mLastChange{};
+        bool mChangePending{false};
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include "hash_utils.h"
+
+namespace {
+    constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+
+    uint64_t rotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t readWord(const unsigned char *p) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    uint64_t mix(uint64_t hash, uint64_t word) {
+        word *= PRIME_2;
+        word = rotateLeft(word, 31);
+        word *= PRIME_1;
+        hash ^= word;
+        return rotateLeft(hash, 27) * PRIME_1 + PRIME_3;
+    }
+}
+
+namespace RenderPlugin {
+    uint64_t hashBytes(const void *data, size_t size, uint64_t seed) {
+        const auto *p = static_cast<const unsigned char *>(data);
+        uint64_t hash = seed + PRIME_3 + static_cast<uint64_t>(size);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            hash = mix(hash, readWord(p + i));
+        }
+        uint64_t tail = 0;
+        for (size_t k = size; k > i; --k) {
+            tail = (tail << 8) | p[k - 1];
+        }
+        hash = mix(hash, tail);
+        // final avalanche
+        hash ^= hash >> 33;
+        hash *= PRIME_2;
+        hash ^= hash >> 29;
+        hash *= PRIME_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
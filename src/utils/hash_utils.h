@@ -0,0 +1,20 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_HASH_UTILS_H
+#define RENDERPLUGIN_HASH_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace RenderPlugin {
+    /** 64 位非加密哈希，用于判断文件或数据内容是否变化；按 8 字节分组处理，结果与平台字节序无关 */
+    uint64_t hashBytes(const void *data, size_t size, uint64_t seed = 0);
+
+    inline uint64_t hashBytes(std::string_view data, uint64_t seed = 0) {
+        return hashBytes(data.data(), data.size(), seed);
+    }
+}
+
+#endif
@@ -0,0 +1,331 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "json_sax_parser.h"
+
+namespace {
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    enum class Expect {
+        Value,
+        FirstValueOrEnd,    // right after '['
+        FirstKeyOrEnd,      // right after '{'
+        Key,
+        CommaOrEnd,
+        Done
+    };
+}
+
+namespace RenderPlugin {
+    JsonParseError::JsonParseError(size_t line, size_t column, const std::string &message)
+            : std::runtime_error("json: error at line " + std::to_string(line) + ", column " +
+                                 std::to_string(column) + ": " + message), mLine(line), mColumn(column) {}
+
+    JsonSaxParser::JsonSaxParser(std::string_view text) : mText(text) {}
+
+    JsonParseError JsonSaxParser::error(const std::string &message) const {
+        const size_t position = (std::min)(mPosition, mText.size());
+        const size_t lineStart = mText.rfind('\n', position == 0 ? 0 : position - 1);
+        const size_t column = lineStart == std::string_view::npos || lineStart >= position ? position + 1
+                                                                                           : position - lineStart;
+        return {line(), column, message};
+    }
+
+    size_t JsonSaxParser::line() const {
+        // the position is only needed on errors, so lines are counted here instead of while scanning
+        const size_t position = (std::min)(mPosition, mText.size());
+        const auto begin = mText.begin();
+        return static_cast<size_t>(std::count(begin, begin + static_cast<ptrdiff_t>(position), '\n')) + 1;
+    }
+
+    void JsonSaxParser::parse(JsonSaxHandler &handler) {
+        mPosition = 0;
+        mStack.clear();
+        if (mText.starts_with("\xEF\xBB\xBF")) {
+            mPosition = 3;
+        }
+        Expect expect = Expect::Value;
+        auto afterValue = [this]() { return mStack.empty() ? Expect::Done : Expect::CommaOrEnd; };
+        while (expect != Expect::Done) {
+            skipWhitespace();
+            if (mPosition >= mText.size()) {
+                throw error("unexpected end of input");
+            }
+            const char c = mText[mPosition];
+            switch (expect) {
+                case Expect::FirstKeyOrEnd:
+                    if (c == '}') {
+                        ++mPosition;
+                        mStack.pop_back();
+                        handler.onObjectEnd();
+                        expect = afterValue();
+                        break;
+                    }
+                    [[fallthrough]];
+                case Expect::Key:
+                    if (c != '"') {
+                        throw error("expected a member name");
+                    }
+                    handler.onKey(parseString());
+                    skipWhitespace();
+                    if (mPosition >= mText.size() || mText[mPosition] != ':') {
+                        throw error("expected ':' after member name");
+                    }
+                    ++mPosition;
+                    expect = Expect::Value;
+                    break;
+                case Expect::CommaOrEnd:
+                    if (c == ',') {
+                        ++mPosition;
+                        expect = mStack.back() ? Expect::Key : Expect::Value;
+                    } else if (c == (mStack.back() ? '}' : ']')) {
+                        ++mPosition;
+                        const bool object = mStack.back();
+                        mStack.pop_back();
+                        object ? handler.onObjectEnd() : handler.onArrayEnd();
+                        expect = afterValue();
+                    } else {
+                        throw error(mStack.back() ? "expected ',' or '}'" : "expected ',' or ']'");
+                    }
+                    break;
+                case Expect::FirstValueOrEnd:
+                    if (c == ']') {
+                        ++mPosition;
+                        mStack.pop_back();
+                        handler.onArrayEnd();
+                        expect = afterValue();
+                        break;
+                    }
+                    [[fallthrough]];
+                case Expect::Value:
+                    switch (c) {
+                        case '{':
+                            ++mPosition;
+                            mStack.push_back(true);
+                            handler.onObjectStart();
+                            expect = Expect::FirstKeyOrEnd;
+                            break;
+                        case '[':
+                            ++mPosition;
+                            mStack.push_back(false);
+                            handler.onArrayStart();
+                            expect = Expect::FirstValueOrEnd;
+                            break;
+                        case '"':
+                            handler.onString(parseString());
+                            expect = afterValue();
+                            break;
+                        case 't':
+                            expectLiteral("true");
+                            handler.onBool(true);
+                            expect = afterValue();
+                            break;
+                        case 'f':
+                            expectLiteral("false");
+                            handler.onBool(false);
+                            expect = afterValue();
+                            break;
+                        case 'n':
+                            expectLiteral("null");
+                            handler.onNull();
+                            expect = afterValue();
+                            break;
+                        default:
+                            if (c != '-' && !isDigit(c)) {
+                                throw error(std::string("unexpected character '") + c + "'");
+                            }
+                            handler.onNumber(parseNumber());
+                            expect = afterValue();
+                            break;
+                    }
+                    break;
+                case Expect::Done:
+                    break;
+            }
+        }
+        skipWhitespace();
+        if (mPosition != mText.size()) {
+            throw error("unexpected content after the top-level value");
+        }
+    }
+
+    void JsonSaxParser::skipWhitespace() {
+        while (mPosition < mText.size()) {
+            const char c = mText[mPosition];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return;
+            }
+            ++mPosition;
+        }
+    }
+
+    std::string_view JsonSaxParser::parseString() {
+        // opening quote
+        ++mPosition;
+        const size_t begin = mPosition;
+        // fast path: strings without escapes are handed out as a view of the input
+        while (mPosition < mText.size()) {
+            const char c = mText[mPosition];
+            if (c == '"') {
+                return mText.substr(begin, mPosition++ - begin);
+            }
+            if (c == '\\') {
+                break;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                throw error("control character in string");
+            }
+            ++mPosition;
+        }
+        mScratch.assign(mText.data() + begin, mPosition - begin);
+        while (mPosition < mText.size()) {
+            const char c = mText[mPosition];
+            if (c == '"') {
+                ++mPosition;
+                return mScratch;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                throw error("control character in string");
+            }
+            if (c != '\\') {
+                mScratch.push_back(c);
+                ++mPosition;
+                continue;
+            }
+            if (++mPosition >= mText.size()) {
+                break;
+            }
+            const char escaped = mText[mPosition++];
+            switch (escaped) {
+                case '"':
+                case '\\':
+                case '/':
+                    mScratch.push_back(escaped);
+                    break;
+                case 'b':
+                    mScratch.push_back('\b');
+                    break;
+                case 'f':
+                    mScratch.push_back('\f');
+                    break;
+                case 'n':
+                    mScratch.push_back('\n');
+                    break;
+                case 'r':
+                    mScratch.push_back('\r');
+                    break;
+                case 't':
+                    mScratch.push_back('\t');
+                    break;
+                case 'u': {
+                    uint32_t codePoint = parseHex4();
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && mText.substr(mPosition, 2) == "\\u") {
+                        // surrogate pair
+                        mPosition += 2;
+                        const uint32_t low = parseHex4();
+                        if (low >= 0xDC00 && low < 0xE000) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            appendCodePoint(0xFFFD);
+                            codePoint = low;
+                        }
+                    }
+                    // lone surrogates cannot be encoded as UTF-8
+                    appendCodePoint(codePoint >= 0xD800 && codePoint < 0xE000 ? 0xFFFD : codePoint);
+                    break;
+                }
+                default:
+                    --mPosition;
+                    throw error(std::string("invalid escape '\\") + escaped + "'");
+            }
+        }
+        throw error("unterminated string");
+    }
+
+    uint32_t JsonSaxParser::parseHex4() {
+        if (mPosition + 4 > mText.size()) {
+            throw error("truncated \\u escape");
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = mText[mPosition++];
+            value <<= 4;
+            if (isDigit(c)) {
+                value |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                value |= c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                value |= c - 'A' + 10;
+            } else {
+                throw error("invalid \\u escape");
+            }
+        }
+        return value;
+    }
+
+    void JsonSaxParser::appendCodePoint(uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            mScratch.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            mScratch.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            mScratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            mScratch.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            mScratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            mScratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            mScratch.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            mScratch.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            mScratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            mScratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    std::string_view JsonSaxParser::parseNumber() {
+        const size_t begin = mPosition;
+        auto digits = [this]() {
+            const size_t start = mPosition;
+            while (mPosition < mText.size() && isDigit(mText[mPosition])) {
+                ++mPosition;
+            }
+            return mPosition - start;
+        };
+        if (mText[mPosition] == '-') {
+            ++mPosition;
+        }
+        const size_t integerStart = mPosition;
+        const size_t integerDigits = digits();
+        if (integerDigits == 0 || (integerDigits > 1 && mText[integerStart] == '0')) {
+            throw error("invalid number");
+        }
+        if (mPosition < mText.size() && mText[mPosition] == '.') {
+            ++mPosition;
+            if (digits() == 0) {
+                throw error("invalid number");
+            }
+        }
+        if (mPosition < mText.size() && (mText[mPosition] == 'e' || mText[mPosition] == 'E')) {
+            ++mPosition;
+            if (mPosition < mText.size() && (mText[mPosition] == '+' || mText[mPosition] == '-')) {
+                ++mPosition;
+            }
+            if (digits() == 0) {
+                throw error("invalid number");
+            }
+        }
+        return mText.substr(begin, mPosition - begin);
+    }
+
+    void JsonSaxParser::expectLiteral(std::string_view literal) {
+        if (mText.substr(mPosition, literal.size()) != literal) {
+            throw error("invalid literal");
+        }
+        mPosition += literal.size();
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_JSON_SAX_PARSER_H
+#define RENDERPLUGIN_JSON_SAX_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RenderPlugin {
+    /** JSON 格式错误，消息中带行列号（从 1 开始） */
+    class JsonParseError : public std::runtime_error {
+    public:
+        JsonParseError(size_t line, size_t column, const std::string &message);
+
+        [[nodiscard]] size_t line() const { return mLine; }
+
+        [[nodiscard]] size_t column() const { return mColumn; }
+
+    private:
+        size_t mLine;
+        size_t mColumn;
+    };
+
+    /**
+     * JSON 事件接收方。对象的每个成员先收到 onKey，随后是其值的事件。
+     * 字符串和数值以视图交出，视图只在回调期间有效；数值为未转换的原文（已按 JSON 语法校验）
+     */
+    class JsonSaxHandler {
+    public:
+        virtual ~JsonSaxHandler() = default;
+
+        virtual void onObjectStart() = 0;
+
+        virtual void onObjectEnd() = 0;
+
+        virtual void onArrayStart() = 0;
+
+        virtual void onArrayEnd() = 0;
+
+        virtual void onKey(std::string_view key) = 0;
+
+        virtual void onString(std::string_view value) = 0;
+
+        virtual void onNumber(std::string_view text) = 0;
+
+        virtual void onBool(bool value) = 0;
+
+        virtual void onNull() = 0;
+    };
+
+    /**
+     * 事件式（SAX）JSON 解析器，不构建文档树。
+     * 直接在输入文本上扫描，嵌套用显式栈处理而非递归；不含转义的字符串和所有数值不做复制。
+     * 输入须为 UTF-8（允许 BOM），只解析一个顶层值，格式错误抛出 JsonParseError
+     */
+    class JsonSaxParser {
+    public:
+        explicit JsonSaxParser(std::string_view text);
+
+        void parse(JsonSaxHandler &handler);
+
+        /** 当前解析位置的错误，供接收方报告语义错误 */
+        [[nodiscard]] JsonParseError error(const std::string &message) const;
+
+        /** 当前解析位置的行号（从 1 开始），供接收方记录不中断解析的数据错误 */
+        [[nodiscard]] size_t line() const;
+
+    private:
+        std::string_view mText;
+        size_t mPosition{0};
+        std::string mScratch;       // 含转义的字符串解码后的内容
+        std::vector<bool> mStack;   // true 为对象，false 为数组
+
+        void skipWhitespace();
+
+        std::string_view parseString();
+
+        std::string_view parseNumber();
+
+        void expectLiteral(std::string_view literal);
+
+        void appendCodePoint(uint32_t codePoint);
+
+        uint32_t parseHex4();
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <cstdint>
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RenderPlugin {
+#ifdef _WIN32
+    std::shared_ptr<const MappedFile> MappedFile::open(const fs::path &path) {
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+            CloseHandle(file);
+            return nullptr;
+        }
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        mapped->mFile = file;
+        if (size.QuadPart == 0) {
+            return mapped;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            return nullptr;
+        }
+        mapped->mMapping = mapping;
+        const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            return nullptr;
+        }
+        mapped->mData = static_cast<const char *>(view);
+        mapped->mSize = static_cast<size_t>(size.QuadPart);
+        mapped->mMapped = true;
+        return mapped;
+    }
+
+    MappedFile::~MappedFile() {
+        if (mMapped) {
+            UnmapViewOfFile(mData);
+        }
+        if (mMapping != nullptr) {
+            CloseHandle(mMapping);
+        }
+        if (mFile != nullptr) {
+            CloseHandle(mFile);
+        }
+    }
+#else
+    std::shared_ptr<const MappedFile> MappedFile::open(const fs::path &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            ::close(fd);
+            return nullptr;
+        }
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        if (info.st_size > 0) {
+            // a shared read-only mapping is backed directly by the page cache, never by private copies
+            void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                return nullptr;
+            }
+            mapped->mData = static_cast<const char *>(view);
+            mapped->mSize = static_cast<size_t>(info.st_size);
+            mapped->mMapped = true;
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        return mapped;
+    }
+
+    MappedFile::~MappedFile() {
+        if (mMapped) {
+            munmap(const_cast<char *>(mData), mSize);
+        }
+    }
+#endif
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_MAPPED_FILE_H
+#define RENDERPLUGIN_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace RenderPlugin {
+    namespace fs = std::filesystem;
+
+    /**
+     * 以只读方式内存映射的整个文件，映射在对象析构时解除。
+     * 映射与系统文件缓存共用页面，多个进程映射同一文件时只占用一份物理内存
+     */
+    class MappedFile {
+    public:
+        /** 映射文件，文件不存在或无法映射时返回 nullptr；空文件返回长度为 0 的映射 */
+        static std::shared_ptr<const MappedFile> open(const fs::path &path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        [[nodiscard]] const char *data() const { return mData; }
+
+        [[nodiscard]] size_t size() const { return mSize; }
+
+        [[nodiscard]] std::string_view view() const { return {mData, mSize}; }
+
+    private:
+        MappedFile() = default;
+
+        const char *mData{""};
+        size_t mSize{0};
+        bool mMapped{false};
+#ifdef _WIN32
+        void *mFile{nullptr};
+        void *mMapping{nullptr};
+#endif
+    };
+}
+
+#endif
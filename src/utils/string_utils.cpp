@@ -3,21 +3,114 @@
 
 #include "string_utils.h"
 
+namespace {
+    constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    // 解码 pos 处的一个 UTF-8 字符并前移 pos，非法序列返回 U+FFFD 并只跳过一个字节
+    char32_t decodeUtf8(std::string_view str, size_t &pos) {
+        const auto lead = static_cast<unsigned char>(str[pos]);
+        if (lead < 0x80) {
+            ++pos;
+            return lead;
+        }
+        size_t length;
+        char32_t codePoint;
+        if ((lead & 0xE0) == 0xC0) {
+            length = 2;
+            codePoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+            codePoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4;
+            codePoint = lead & 0x07;
+        } else {
+            ++pos;
+            return REPLACEMENT_CHARACTER;
+        }
+        if (pos + length > str.size()) {
+            ++pos;
+            return REPLACEMENT_CHARACTER;
+        }
+        for (size_t i = 1; i < length; ++i) {
+            const auto c = static_cast<unsigned char>(str[pos + i]);
+            if ((c & 0xC0) != 0x80) {
+                ++pos;
+                return REPLACEMENT_CHARACTER;
+            }
+            codePoint = (codePoint << 6) | (c & 0x3F);
+        }
+        constexpr char32_t MIN_CODE_POINT[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (codePoint < MIN_CODE_POINT[length] || codePoint > 0x10FFFF ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            ++pos;
+            return REPLACEMENT_CHARACTER;
+        }
+        pos += length;
+        return codePoint;
+    }
+
+    void appendUtf8(std::string &out, char32_t codePoint) {
+        if (codePoint < 0x80) {
+            out.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
+
 namespace RenderPlugin {
-    std::wstring Utf8ToWstring(const std::string &str) {
+    std::wstring Utf8ToWstring(std::string_view str) {
         if (str.empty()) return {};
-        int size_needed = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int) str.size(), nullptr, 0);
-        std::wstring wstr(size_needed, 0);
-        MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int) str.size(), &wstr[0], size_needed);
+        std::wstring wstr;
+        wstr.reserve(str.size());
+        size_t pos = 0;
+        while (pos < str.size()) {
+            char32_t codePoint = decodeUtf8(str, pos);
+            if constexpr (sizeof(wchar_t) == 2) {
+                if (codePoint >= 0x10000) {
+                    codePoint -= 0x10000;
+                    wstr.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+                    wstr.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+                    continue;
+                }
+            }
+            wstr.push_back(static_cast<wchar_t>(codePoint));
+        }
         return wstr;
     }
 
     std::string WstringToUtf8(const std::wstring &wstr) {
         if (wstr.empty()) return {};
-        int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int) wstr.size(),
-                                              nullptr, 0, nullptr, nullptr);
-        std::string str(size_needed, 0);
-        WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int) wstr.size(), &str[0], size_needed, nullptr, nullptr);
+        std::string str;
+        str.reserve(wstr.size());
+        for (size_t i = 0; i < wstr.size(); ++i) {
+            auto codePoint = static_cast<char32_t>(wstr[i]);
+            if constexpr (sizeof(wchar_t) == 2) {
+                codePoint &= 0xFFFF;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < wstr.size()) {
+                    const auto low = static_cast<char32_t>(wstr[i + 1]) & 0xFFFF;
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        ++i;
+                    }
+                }
+            }
+            if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF) {
+                codePoint = REPLACEMENT_CHARACTER;
+            }
+            appendUtf8(str, codePoint);
+        }
         return str;
     }
 
@@ -4,11 +4,12 @@
 #ifndef RENDERPLUGIN_STRING_UTILS_H
 #define RENDERPLUGIN_STRING_UTILS_H
 
-#include <windows.h>
 #include <string>
+#include <string_view>
 
 namespace RenderPlugin {
-    std::wstring Utf8ToWstring(const std::string &str);
+    // wchar_t 为 2 字节（Windows）时按 UTF-16 编码，否则按 UTF-32；非法 UTF-8 序列替换为 U+FFFD
+    std::wstring Utf8ToWstring(std::string_view str);
     std::string WstringToUtf8(const std::wstring &wstr);
 }
 #endif
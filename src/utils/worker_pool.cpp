@@ -0,0 +1,47 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+
+#include "worker_pool.h"
+
+namespace RenderPlugin {
+    WorkerPool::WorkerPool(size_t threadCount) {
+        threadCount = (std::max)(threadCount, static_cast<size_t>(1));
+        mThreads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            mThreads.emplace_back([this] { run(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto &thread: mThreads) {
+            thread.join();
+        }
+    }
+
+    size_t WorkerPool::defaultThreadCount() {
+        return (std::max)(std::thread::hardware_concurrency(), 1u);
+    }
+
+    void WorkerPool::run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mMutex);
+                mCondition.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+                if (mTasks.empty()) {
+                    return;
+                }
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#ifndef RENDERPLUGIN_WORKER_POOL_H
+#define RENDERPLUGIN_WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RenderPlugin {
+    /**
+     * 固定大小的工作线程池，任务按提交顺序取出执行。
+     * 析构时先执行完已提交的任务再退出，因此任务引用的局部数据只需比线程池活得久。
+     */
+    class WorkerPool {
+    public:
+        explicit WorkerPool(size_t threadCount = defaultThreadCount());
+
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool &) = delete;
+
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        /** 提交任务，任务抛出的异常在 future::get() 时重新抛出 */
+        template<typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<F>> {
+            using Result = std::invoke_result_t<F>;
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+            {
+                std::lock_guard lock(mMutex);
+                mTasks.emplace_back([packaged] { (*packaged)(); });
+            }
+            mCondition.notify_one();
+            return future;
+        }
+
+        [[nodiscard]] size_t size() const { return mThreads.size(); }
+
+        /** 硬件线程数，无法获取时为 1 */
+        static size_t defaultThreadCount();
+
+    private:
+        std::vector<std::thread> mThreads;
+        std::deque<std::function<void()>> mTasks;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mStopping{false};
+
+        void run();
+    };
+}
+
+#endif
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "feature_store_binary.h"
+
+namespace RenderPlugin {
+    namespace {
+        constexpr uint64_t SOURCE_HASH = 0x1234567890ABCDEFull;
+
+        FeatureStore makeStore(CoordinateStorage storage) {
+            FeatureStore store(storage);
+            Palette palette;
+            auto append = [&](RenderType type, std::string text, Coordinates coordinates) {
+                RenderData data;
+                data.mType = type;
+                data.mRawColor = "#FF0000";
+                data.mColor = palette.intern(Color(255, 0, 0));
+                data.mText = std::move(text);
+                data.mZoom = 5;
+                data.mCoordinates = std::move(coordinates);
+                store.append(std::move(data));
+            };
+            append(RenderType::LINE, "", {{116.0, 39.0}, {117.0, 40.0}});
+            append(RenderType::AREA, "", {{120.0, 30.0}, {121.0, 30.0}, {121.0, 31.0}});
+            append(RenderType::TEXT, "ZSSS", {{121.3, 31.2}});
+            store.setPalette(std::move(palette));
+            store.setSourceHashes(std::vector<uint64_t>{1, 2, 3});
+            store.finalize();
+            return store;
+        }
+
+        class FeatureStoreBinaryTest : public testing::Test {
+        protected:
+            fs::path mDirectory;
+            fs::path mPath;
+
+            void SetUp() override {
+                mDirectory = fs::temp_directory_path() /
+                             ("erp_binary_" +
+                              std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+                fs::create_directories(mDirectory);
+                mPath = mDirectory / "config.erpbin";
+            }
+
+            void TearDown() override {
+                std::error_code ec;
+                fs::remove_all(mDirectory, ec);
+            }
+
+            [[nodiscard]] std::string readAll() const {
+                std::ifstream in(mPath, std::ios::binary);
+                return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+            }
+
+            void writeAll(const std::string &bytes) const {
+                std::ofstream(mPath, std::ios::binary | std::ios::trunc) << bytes;
+            }
+        };
+    }
+
+    TEST_F(FeatureStoreBinaryTest, RoundTripReadsColumnsInPlace) {
+        const FeatureStore store = makeStore(CoordinateStorage::Double);
+        ASSERT_TRUE(FeatureStoreBinary::write(store, SOURCE_HASH, mPath));
+
+        auto file = MappedFile::open(mPath);
+        ASSERT_NE(file, nullptr);
+        const char *begin = file->data();
+        const char *end = begin + file->size();
+        auto loaded = FeatureStoreBinary::load(file);
+        ASSERT_NE(loaded, nullptr);
+        ASSERT_EQ(loaded->size(), 3u);
+        EXPECT_EQ(loaded->text(2), L"ZSSS");
+        EXPECT_EQ(loaded->coordinates(1)[2].mLatitude, 31.0);
+        EXPECT_EQ(loaded->palette()[loaded->style(0).mColor], Color(255, 0, 0));
+
+        // the columns point into the mapping instead of a copy
+        const auto hashes = loaded->sourceHashes();
+        ASSERT_EQ(hashes.size(), 3u);
+        EXPECT_GE(reinterpret_cast<const char *>(hashes.data()), begin);
+        EXPECT_LE(reinterpret_cast<const char *>(hashes.data() + hashes.size()), end);
+
+        std::vector<FeatureStore::FeatureIndex> visible;
+        loaded->queryFeatures({115.0, 38.0, 118.0, 41.0}, 7, visible);
+        EXPECT_EQ(visible, std::vector<FeatureStore::FeatureIndex>{0});
+    }
+
+    TEST_F(FeatureStoreBinaryTest, RejectsStaleCaches) {
+        ASSERT_TRUE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Quantized), SOURCE_HASH, mPath));
+        EXPECT_NE(FeatureStoreBinary::load(mPath, SOURCE_HASH, CoordinateStorage::Quantized), nullptr);
+        EXPECT_EQ(FeatureStoreBinary::load(mPath, SOURCE_HASH + 1, CoordinateStorage::Quantized), nullptr);
+        EXPECT_EQ(FeatureStoreBinary::load(mPath, SOURCE_HASH, CoordinateStorage::Double), nullptr);
+        EXPECT_EQ(FeatureStoreBinary::load(mDirectory / "missing.erpbin"), nullptr);
+    }
+
+    TEST_F(FeatureStoreBinaryTest, RejectsTruncatedFiles) {
+        ASSERT_TRUE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Double), SOURCE_HASH, mPath));
+        const std::string bytes = readAll();
+        for (const size_t size: {size_t{0}, size_t{7}, size_t{64}, bytes.size() / 2, bytes.size() - 8}) {
+            writeAll(bytes.substr(0, size));
+            EXPECT_EQ(FeatureStoreBinary::load(mPath, SOURCE_HASH, CoordinateStorage::Double), nullptr) << size;
+        }
+    }
+
+    TEST_F(FeatureStoreBinaryTest, RejectsCorruptFiles) {
+        ASSERT_TRUE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Double), SOURCE_HASH, mPath));
+        const std::string bytes = readAll();
+
+        std::string badMagic = bytes;
+        badMagic[0] = 'X';
+        writeAll(badMagic);
+        EXPECT_EQ(FeatureStoreBinary::load(mPath), nullptr);
+
+        std::string badVersion = bytes;
+        badVersion[8] = static_cast<char>(FeatureStoreBinary::VERSION + 1);
+        writeAll(badVersion);
+        EXPECT_EQ(FeatureStoreBinary::load(mPath), nullptr);
+
+        // the header is intact, the sections are not: offsets, counts and indices are out of range
+        std::string badSections = bytes;
+        for (size_t i = bytes.size() / 2; i < bytes.size(); ++i) {
+            badSections[i] = static_cast<char>(0xFF);
+        }
+        writeAll(badSections);
+        EXPECT_EQ(FeatureStoreBinary::load(mPath), nullptr);
+    }
+
+    TEST_F(FeatureStoreBinaryTest, WriteReplacesCacheAndLeavesNoTemporaryFile) {
+        ASSERT_TRUE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Double), SOURCE_HASH, mPath));
+        // an existing mapping keeps the old content when the cache is replaced
+        auto old = FeatureStoreBinary::load(mPath, SOURCE_HASH, CoordinateStorage::Double);
+        ASSERT_NE(old, nullptr);
+        ASSERT_TRUE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Double), SOURCE_HASH + 1, mPath));
+        EXPECT_NE(FeatureStoreBinary::load(mPath, SOURCE_HASH + 1, CoordinateStorage::Double), nullptr);
+        EXPECT_EQ(old->text(2), L"ZSSS");
+
+        size_t files = 0;
+        for (const auto &entry: fs::directory_iterator(mDirectory)) {
+            EXPECT_EQ(entry.path().filename(), "config.erpbin");
+            ++files;
+        }
+        EXPECT_EQ(files, 1u);
+    }
+
+    TEST_F(FeatureStoreBinaryTest, WriteReportsWhyItFailed) {
+        std::error_code error;
+        EXPECT_FALSE(FeatureStoreBinary::write(makeStore(CoordinateStorage::Double), SOURCE_HASH,
+                                               mDirectory / "missing" / "config.erpbin", error));
+        EXPECT_TRUE(error);
+        EXPECT_FALSE(fs::exists(mDirectory / "missing"));
+    }
+}
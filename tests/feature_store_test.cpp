@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "feature_store.h"
+
+namespace RenderPlugin {
+    namespace {
+        RenderData makeFeature(Palette &palette, RenderType type, const Color &color, std::string text,
+                               Coordinates coordinates) {
+            RenderData data;
+            data.mType = type;
+            data.mRawColor = "#" + std::to_string(color.red);
+            data.mColor = palette.intern(color);
+            data.mText = std::move(text);
+            data.mZoom = 7;
+            data.mMaxZoom = 12;
+            data.mCoordinates = std::move(coordinates);
+            return data;
+        }
+
+        void expectSameFeature(const FeatureStore &a, FeatureStore::FeatureIndex i,
+                               const FeatureStore &b, FeatureStore::FeatureIndex j) {
+            EXPECT_EQ(a.type(i), b.type(j));
+            EXPECT_EQ(a.zoom(i), b.zoom(j));
+            EXPECT_EQ(a.maxZoom(i), b.maxZoom(j));
+            EXPECT_EQ(a.text(i), b.text(j));
+            EXPECT_EQ(a.palette()[a.style(i).mColor], b.palette()[b.style(j).mColor]);
+            EXPECT_EQ(a.rawColors(i).mRawColor, b.rawColors(j).mRawColor);
+            ASSERT_EQ(a.coordinates(i).size(), b.coordinates(j).size());
+            for (size_t k = 0; k < a.coordinates(i).size(); ++k) {
+                EXPECT_EQ(a.coordinates(i)[k].mLongitude, b.coordinates(j)[k].mLongitude);
+                EXPECT_EQ(a.coordinates(i)[k].mLatitude, b.coordinates(j)[k].mLatitude);
+            }
+            EXPECT_EQ(a.bounds(i).mMinLongitude, b.bounds(j).mMinLongitude);
+            EXPECT_EQ(a.bounds(i).mMaxLatitude, b.bounds(j).mMaxLatitude);
+        }
+    }
+
+    TEST(FeatureStore, AppendComputesBoundsAndInternsStyles) {
+        FeatureStore store;
+        Palette palette;
+        const Color red(255, 0, 0);
+        store.append(makeFeature(palette, RenderType::LINE, red, "", {{100.0, 30.0}, {101.0, 31.5}}));
+        store.append(makeFeature(palette, RenderType::LINE, red, "", {{102.0, 29.0}, {103.0, 30.0}}));
+        store.append(makeFeature(palette, RenderType::TEXT, red, "ZBAA", {{116.4, 40.1}}));
+        store.setPalette(palette);
+
+        ASSERT_EQ(store.size(), 3u);
+        EXPECT_EQ(store.coordinateCount(), 5u);
+        EXPECT_EQ(store.styleId(0), store.styleId(1));
+        EXPECT_EQ(store.bounds(0).mMinLongitude, 100.0);
+        EXPECT_EQ(store.bounds(0).mMaxLatitude, 31.5);
+        EXPECT_EQ(store.text(2), L"ZBAA");
+    }
+
+    TEST(FeatureStore, ImportRemapsPaletteLabelsAndRawColors) {
+        FeatureStore source;
+        Palette sourcePalette;
+        source.append(makeFeature(sourcePalette, RenderType::LINE, Color(10, 20, 30), "", {{1.0, 2.0}, {3.0, 4.0}}));
+        source.append(makeFeature(sourcePalette, RenderType::TEXT, Color(40, 50, 60), "LABEL", {{5.0, 6.0}}));
+        source.append(makeFeature(sourcePalette, RenderType::AREA, Color(10, 20, 30), "",
+                                  {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}}));
+        source.setPalette(sourcePalette);
+
+        // the target already has other colors and labels, so every index has to be remapped
+        FeatureStore target;
+        Palette targetPalette;
+        target.append(makeFeature(targetPalette, RenderType::TEXT, Color(40, 50, 60), "OTHER", {{9.0, 9.0}}));
+        target.setPalette(targetPalette);
+
+        FeatureImporter importer(target, source);
+        const auto first = importer.import(2);
+        const auto second = importer.import(1);
+        const auto third = importer.import(0);
+
+        ASSERT_EQ(target.size(), 4u);
+        expectSameFeature(source, 2, target, first);
+        expectSameFeature(source, 1, target, second);
+        expectSameFeature(source, 0, target, third);
+        EXPECT_EQ(target.text(0), L"OTHER");
+        // styles shared in the source stay shared after import
+        EXPECT_EQ(target.styleId(first), target.styleId(third));
+        EXPECT_EQ(target.palette().size(), 3u);
+    }
+
+    TEST(FeatureStore, ImportQuantizedCoordinates) {
+        FeatureStore source(CoordinateStorage::Quantized);
+        Palette palette;
+        source.append(makeFeature(palette, RenderType::LINE, Color(1, 2, 3), "", {{116.1234567, 39.7654321},
+                                                                                  {116.2, 39.8}}));
+        source.setPalette(palette);
+        FeatureStore target(CoordinateStorage::Quantized);
+        FeatureImporter importer(target, source);
+        const auto index = importer.import(0);
+        expectSameFeature(source, 0, target, index);
+        EXPECT_NEAR(target.coordinates(index)[0].mLongitude, 116.1234567, 1e-7);
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "file_watcher.h"
+#include "hash_utils.h"
+
+namespace RenderPlugin {
+    namespace {
+        using namespace std::chrono_literals;
+
+        class FileWatcherTest : public testing::Test {
+        protected:
+            fs::path mPath;
+
+            void SetUp() override {
+                mPath = fs::temp_directory_path() /
+                        ("erp_file_watcher_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) +
+                         ".yaml");
+                write("color: {}\n");
+            }
+
+            void TearDown() override {
+                std::error_code ec;
+                fs::remove(mPath, ec);
+            }
+
+            void write(std::string_view text) const {
+                std::ofstream(mPath, std::ios::binary | std::ios::trunc) << text;
+            }
+
+            [[nodiscard]] WatchedFile stamp(std::string_view text) const {
+                return WatchedFile::stat(mPath, hashBytes(text));
+            }
+        };
+    }
+
+    TEST_F(FileWatcherTest, ContentChangedComparesHashes) {
+        EXPECT_FALSE(contentChanged({stamp("color: {}\n")}));
+        EXPECT_TRUE(contentChanged({stamp("features: []\n")}));
+
+        WatchedFile missing = WatchedFile::stat(mPath.string() + ".missing");
+        EXPECT_FALSE(missing.mExists);
+        EXPECT_TRUE(contentChanged({missing}));
+    }
+
+    TEST_F(FileWatcherTest, PollReportsSettledStampChangeAndKeepsHash) {
+        FileWatcher watcher(1s);
+        watcher.watch({stamp("color: {}\n")});
+        const auto start = FileWatcher::Clock::now();
+        EXPECT_FALSE(watcher.poll(start));
+
+        // same length, so only the write time tells the edit apart
+        write("color: []\n");
+        fs::last_write_time(mPath, fs::last_write_time(mPath) + 2s);
+        EXPECT_FALSE(watcher.poll(start));
+        EXPECT_FALSE(watcher.poll(start + 500ms));
+        EXPECT_TRUE(watcher.poll(start + 1500ms));
+        EXPECT_FALSE(watcher.poll(start + 3s));
+
+        // the baseline keeps the hash of the content last loaded, the caller compares it off the UI thread
+        ASSERT_EQ(watcher.files().size(), 1u);
+        EXPECT_EQ(watcher.files()[0].mContentHash, hashBytes("color: {}\n"));
+        EXPECT_TRUE(contentChanged(watcher.files()));
+    }
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "geometry_utils.h"
+
+namespace RenderPlugin {
+    namespace {
+        const PixelRect SCREEN{0, 0, 100, 100};
+
+        GeoRect geoRect(double minLongitude, double minLatitude, double maxLongitude, double maxLatitude) {
+            GeoRect rect;
+            rect.expand(minLongitude, minLatitude);
+            rect.expand(maxLongitude, maxLatitude);
+            return rect;
+        }
+    }
+
+    TEST(GeometryUtils, PointInRectIncludesEdges) {
+        EXPECT_TRUE(pointInRect({0, 0}, SCREEN));
+        EXPECT_TRUE(pointInRect({100, 100}, SCREEN));
+        EXPECT_TRUE(pointInRect({50, 50}, SCREEN));
+        EXPECT_FALSE(pointInRect({101, 50}, SCREEN));
+        EXPECT_FALSE(pointInRect({50, -1}, SCREEN));
+    }
+
+    TEST(GeometryUtils, SegmentsIntersect) {
+        EXPECT_TRUE(segmentsIntersect({0, 0}, {10, 10}, {0, 10}, {10, 0}));
+        EXPECT_FALSE(segmentsIntersect({0, 0}, {10, 0}, {0, 5}, {10, 5}));
+        // touching end points and collinear overlap both count
+        EXPECT_TRUE(segmentsIntersect({0, 0}, {5, 5}, {5, 5}, {10, 0}));
+        EXPECT_TRUE(segmentsIntersect({0, 0}, {10, 0}, {5, 0}, {15, 0}));
+        EXPECT_FALSE(segmentsIntersect({0, 0}, {4, 0}, {5, 0}, {15, 0}));
+    }
+
+    TEST(GeometryUtils, SegmentCrossingRectWithoutEndPointsInside) {
+        EXPECT_TRUE(segmentIntersectsRect({-50, 50}, {150, 50}, SCREEN));
+        EXPECT_TRUE(segmentIntersectsRect({50, 50}, {500, 500}, SCREEN));
+        EXPECT_FALSE(segmentIntersectsRect({-50, -10}, {150, -10}, SCREEN));
+    }
+
+    TEST(GeometryUtils, PointInPolygon) {
+        const std::vector<PixelPoint> triangle{{0, 0}, {100, 0}, {0, 100}};
+        EXPECT_TRUE(pointInPolygon({10, 10}, triangle));
+        EXPECT_FALSE(pointInPolygon({90, 90}, triangle));
+        EXPECT_FALSE(pointInPolygon({10, 10}, {{0, 0}, {100, 0}}));
+    }
+
+    TEST(GeometryUtils, AnyPointInRect) {
+        EXPECT_TRUE(isAnyPointInRect({{-10, -10}, {50, 50}}, SCREEN));
+        EXPECT_FALSE(isAnyPointInRect({{-10, -10}, {200, 200}}, SCREEN));
+        EXPECT_FALSE(isAnyPointInRect({}, SCREEN));
+    }
+
+    TEST(GeometryUtils, PolygonIntersectingRect) {
+        // vertex inside
+        EXPECT_TRUE(isPolygonIntersectingRect({{50, 50}, {150, 50}, {150, 150}}, SCREEN));
+        // edge crosses the rect, no vertex inside
+        EXPECT_TRUE(isPolygonIntersectingRect({{-50, 40}, {150, 40}, {150, 60}, {-50, 60}}, SCREEN));
+        // polygon encloses the whole rect
+        EXPECT_TRUE(isPolygonIntersectingRect({{-100, -100}, {200, -100}, {200, 200}, {-100, 200}}, SCREEN));
+        EXPECT_FALSE(isPolygonIntersectingRect({{200, 200}, {300, 200}, {300, 300}}, SCREEN));
+        EXPECT_FALSE(isPolygonIntersectingRect({{50, 50}, {60, 60}}, SCREEN));
+    }
+
+    TEST(GeometryUtils, GeoRectsIntersect) {
+        const GeoRect view = geoRect(100.0, 30.0, 102.0, 32.0);
+        EXPECT_TRUE(geoRectsIntersect(view, geoRect(101.0, 31.0, 101.5, 31.5)));
+        EXPECT_TRUE(geoRectsIntersect(view, geoRect(102.0, 32.0, 103.0, 33.0)));
+        EXPECT_FALSE(geoRectsIntersect(view, geoRect(102.1, 30.0, 103.0, 32.0)));
+        EXPECT_FALSE(geoRectsIntersect(view, GeoRect()));
+        EXPECT_FALSE(geoRectsIntersect(GeoRect(), GeoRect()));
+    }
+
+    TEST(GeometryUtils, GeoPointInRect) {
+        const GeoRect view = geoRect(100.0, 30.0, 102.0, 32.0);
+        EXPECT_TRUE(geoPointInRect(100.0, 30.0, view));
+        EXPECT_TRUE(geoPointInRect(101.0, 31.0, view));
+        EXPECT_FALSE(geoPointInRect(99.9, 31.0, view));
+        EXPECT_FALSE(geoPointInRect(101.0, 31.0, GeoRect()));
+    }
+
+    TEST(GeometryUtils, UnwrapLongitude) {
+        EXPECT_DOUBLE_EQ(unwrapLongitude(100.0, 90.0), 100.0);
+        // east of the antimeridian seen from the west, and the other way round
+        EXPECT_DOUBLE_EQ(unwrapLongitude(-179.0, 179.0), 181.0);
+        EXPECT_DOUBLE_EQ(unwrapLongitude(179.0, -179.0), -181.0);
+        EXPECT_DOUBLE_EQ(unwrapLongitude(530.0, 0.0), 170.0);
+    }
+
+    TEST(GeometryUtils, SplitAtAntimeridian) {
+        const GeoClipRects inside = splitAtAntimeridian(geoRect(100.0, 30.0, 102.0, 32.0));
+        EXPECT_EQ(inside[0].mMinLongitude, 100.0);
+        EXPECT_EQ(inside[0].mMaxLongitude, 102.0);
+        EXPECT_TRUE(inside[1].empty());
+
+        // unwrapped past 180: the part beyond it continues from -180
+        const GeoClipRects east = splitAtAntimeridian(geoRect(170.0, -10.0, 190.0, 10.0));
+        EXPECT_EQ(east[0].mMinLongitude, 170.0);
+        EXPECT_EQ(east[0].mMaxLongitude, 180.0);
+        EXPECT_EQ(east[1].mMinLongitude, -180.0);
+        EXPECT_EQ(east[1].mMaxLongitude, -170.0);
+        EXPECT_EQ(east[1].mMinLatitude, -10.0);
+        EXPECT_EQ(east[1].mMaxLatitude, 10.0);
+        EXPECT_TRUE(geoPointInRect(-175.0, 0.0, east[1]));
+
+        // unwrapped past -180 is moved into range first
+        const GeoClipRects west = splitAtAntimeridian(geoRect(-190.0, 0.0, -170.0, 5.0));
+        EXPECT_EQ(west[0].mMinLongitude, 170.0);
+        EXPECT_EQ(west[0].mMaxLongitude, 180.0);
+        EXPECT_EQ(west[1].mMinLongitude, -180.0);
+        EXPECT_EQ(west[1].mMaxLongitude, -170.0);
+
+        const GeoClipRects world = splitAtAntimeridian(geoRect(-200.0, -90.0, 200.0, 90.0));
+        EXPECT_EQ(world[0].mMinLongitude, -180.0);
+        EXPECT_EQ(world[0].mMaxLongitude, 180.0);
+        EXPECT_TRUE(world[1].empty());
+
+        EXPECT_TRUE(splitAtAntimeridian(GeoRect())[0].empty());
+        EXPECT_TRUE(splitAtAntimeridian(GeoRect())[1].empty());
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "json_sax_parser.h"
+
+namespace RenderPlugin {
+    namespace {
+        /** 把事件记成一行行文本，字符串和数值在回调中复制 */
+        class Recorder : public JsonSaxHandler {
+        public:
+            std::vector<std::string> mEvents;
+            std::vector<const char *> mNumberData;
+
+            void onObjectStart() override { mEvents.emplace_back("{"); }
+
+            void onObjectEnd() override { mEvents.emplace_back("}"); }
+
+            void onArrayStart() override { mEvents.emplace_back("["); }
+
+            void onArrayEnd() override { mEvents.emplace_back("]"); }
+
+            void onKey(std::string_view key) override { mEvents.push_back("key " + std::string(key)); }
+
+            void onString(std::string_view value) override { mEvents.push_back("string " + std::string(value)); }
+
+            void onNumber(std::string_view text) override {
+                mEvents.push_back("number " + std::string(text));
+                mNumberData.push_back(text.data());
+            }
+
+            void onBool(bool value) override { mEvents.emplace_back(value ? "true" : "false"); }
+
+            void onNull() override { mEvents.emplace_back("null"); }
+        };
+
+        std::vector<std::string> events(std::string_view text) {
+            Recorder recorder;
+            JsonSaxParser(text).parse(recorder);
+            return recorder.mEvents;
+        }
+
+        JsonParseError parseError(std::string_view text) {
+            Recorder recorder;
+            try {
+                JsonSaxParser(text).parse(recorder);
+            } catch (const JsonParseError &error) {
+                return error;
+            }
+            ADD_FAILURE() << "no error for " << text;
+            return {0, 0, ""};
+        }
+    }
+
+    TEST(JsonSaxParser, ReportsEventsInDocumentOrder) {
+        const std::vector<std::string> expected = {
+                "{", "key a", "[", "number 1", "true", "false", "null", "]",
+                "key b", "{", "}", "key c", "[", "]", "key d", "string x", "}"
+        };
+        EXPECT_EQ(events("\xEF\xBB\xBF {\"a\": [1, true, false, null], \"b\": {}, \"c\": [],\n\"d\": \"x\"}\n"),
+                  expected);
+        EXPECT_EQ(events("42"), std::vector<std::string>{"number 42"});
+    }
+
+    TEST(JsonSaxParser, DecodesEscapesAndSurrogatePairs) {
+        EXPECT_EQ(events(R"("a\"b\\c\/d\b\f\n\r\t")"), std::vector<std::string>{"string a\"b\\c/d\b\f\n\r\t"});
+        EXPECT_EQ(events(R"("\u0041\u00e9\u4e2d")"), std::vector<std::string>{"string A\xC3\xA9\xE4\xB8\xAD"});
+        // U+1F600 as a surrogate pair
+        EXPECT_EQ(events(R"("\ud83d\ude00")"), std::vector<std::string>{"string \xF0\x9F\x98\x80"});
+        // lone surrogates become U+FFFD
+        EXPECT_EQ(events(R"("\ud83dx")"), std::vector<std::string>{"string \xEF\xBF\xBDx"});
+        EXPECT_EQ(events(R"("\ude00")"), std::vector<std::string>{"string \xEF\xBF\xBD"});
+        EXPECT_EQ(events(R"("\ud83d\u0041")"), std::vector<std::string>{"string \xEF\xBF\xBD" "A"});
+    }
+
+    TEST(JsonSaxParser, NumbersAreViewsOfTheSource) {
+        constexpr std::string_view TEXT = "[-0, 12.5e-3, 1E+2, 0.25]";
+        Recorder recorder;
+        JsonSaxParser(TEXT).parse(recorder);
+        const std::vector<std::string> expected = {"[", "number -0", "number 12.5e-3", "number 1E+2", "number 0.25", "]"};
+        EXPECT_EQ(recorder.mEvents, expected);
+        ASSERT_EQ(recorder.mNumberData.size(), 4u);
+        EXPECT_EQ(recorder.mNumberData[0], TEXT.data() + 1);
+        EXPECT_EQ(recorder.mNumberData[3], TEXT.data() + TEXT.find("0.25"));
+    }
+
+    TEST(JsonSaxParser, RejectsInvalidNumbersAndLiterals) {
+        for (const std::string_view text: {"01", "1.", ".5", "-", "1e", "+1", "tru", "nul", "NaN"}) {
+            parseError(text);
+        }
+    }
+
+    TEST(JsonSaxParser, ErrorsCarryLineAndColumn) {
+        const JsonParseError error = parseError("{\n  \"a\": 1,\n  \"b\" 2\n}");
+        EXPECT_EQ(error.line(), 3u);
+        EXPECT_EQ(error.column(), 7u);
+        EXPECT_NE(std::string(error.what()).find("line 3, column 7"), std::string::npos);
+
+        const JsonParseError first = parseError("x");
+        EXPECT_EQ(first.line(), 1u);
+        EXPECT_EQ(first.column(), 1u);
+
+        EXPECT_EQ(parseError("[1, 2").line(), 1u);
+        EXPECT_EQ(parseError("{\"a\": \"b\nc\"}").line(), 1u);
+        // points at the escaped character
+        EXPECT_EQ(parseError("\"\\x\"").column(), 3u);
+    }
+
+    TEST(JsonSaxParser, RejectsMalformedStructure) {
+        for (const std::string_view text: {"", "{", "[1,]", "{\"a\" 1}", "{1: 2}", "[1 2]", "{} {}", "[}", "\"abc",
+                                           "\"\\u12\""}) {
+            parseError(text);
+        }
+    }
+}
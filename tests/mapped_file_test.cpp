@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "mapped_file.h"
+
+namespace RenderPlugin {
+    namespace {
+        class MappedFileTest : public testing::Test {
+        protected:
+            fs::path mPath;
+
+            void SetUp() override {
+                mPath = fs::temp_directory_path() /
+                        ("erp_mapped_file_" +
+                         std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".bin");
+            }
+
+            void TearDown() override {
+                std::error_code ec;
+                fs::remove(mPath, ec);
+            }
+
+            void write(std::string_view text) const {
+                std::ofstream(mPath, std::ios::binary | std::ios::trunc) << text;
+            }
+        };
+    }
+
+    TEST_F(MappedFileTest, MapsWholeFile) {
+        constexpr std::string_view TEXT = "color:\n  red: \"#FF0000\"\n";
+        write(TEXT);
+        auto file = MappedFile::open(mPath);
+        ASSERT_NE(file, nullptr);
+        EXPECT_EQ(file->size(), TEXT.size());
+        EXPECT_EQ(file->view(), TEXT);
+    }
+
+    TEST_F(MappedFileTest, ViewPointsIntoTheMapping) {
+        write("features: []\n");
+        auto file = MappedFile::open(mPath);
+        ASSERT_NE(file, nullptr);
+        // read in place, no copy is made
+        const std::string_view view = file->view();
+        EXPECT_EQ(view.data(), file->data());
+        EXPECT_EQ(view.substr(0, 8), "features");
+    }
+
+    TEST_F(MappedFileTest, EmptyAndMissingFiles) {
+        write("");
+        auto empty = MappedFile::open(mPath);
+        ASSERT_NE(empty, nullptr);
+        EXPECT_EQ(empty->size(), 0u);
+        EXPECT_TRUE(empty->view().empty());
+
+        EXPECT_EQ(MappedFile::open(mPath.string() + ".missing"), nullptr);
+        EXPECT_EQ(MappedFile::open(fs::temp_directory_path()), nullptr);
+    }
+
+    TEST_F(MappedFileTest, MappingsOfOneFileShareItsPages) {
+        write("0123456789");
+        auto first = MappedFile::open(mPath);
+        auto second = MappedFile::open(mPath);
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        EXPECT_NE(first->data(), second->data());
+        EXPECT_EQ(first->view(), second->view());
+
+        // both mappings are backed by the file cache, a write to the file is seen through each of them
+        {
+            std::fstream out(mPath, std::ios::binary | std::ios::in | std::ios::out);
+            out.seekp(2);
+            out.write("AB", 2);
+        }
+        EXPECT_EQ(first->view(), "01AB456789");
+        EXPECT_EQ(second->view(), "01AB456789");
+
+        // a mapping outlives the other one
+        first.reset();
+        EXPECT_EQ(second->view(), "01AB456789");
+    }
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "render_data_geojson_provider.h"
+#include "render_data_geojson_stream.h"
+
+namespace RenderPlugin {
+    namespace {
+        struct ReadResult {
+            std::vector<std::pair<std::string, std::string>> mColors;
+            std::vector<RenderData> mFeatures;
+            std::vector<DecodeError> mErrors;
+            size_t mSkippedFeatures{0};
+        };
+
+        ReadResult read(std::string_view text) {
+            ReadResult result;
+            RenderDataGeoJsonReader reader({
+                    [&result](const std::string &name, const std::string &value) {
+                        result.mColors.emplace_back(name, value);
+                    },
+                    nullptr,
+                    [&result](RenderData &&data) { result.mFeatures.push_back(std::move(data)); }
+            });
+            reader.read(text);
+            result.mErrors = reader.errors();
+            result.mSkippedFeatures = reader.skippedFeatures();
+            return result;
+        }
+
+        std::string collection(std::string_view features) {
+            return "{\"type\": \"FeatureCollection\", \"features\": [" + std::string(features) + "]}";
+        }
+
+        std::string feature(std::string_view geometry, std::string_view properties = "{}") {
+            return "{\"type\": \"Feature\", \"properties\": " + std::string(properties) +
+                   ", \"geometry\": " + std::string(geometry) + "}";
+        }
+    }
+
+    TEST(GeoJsonReader, MapsGeometriesToFeatures) {
+        const ReadResult result = read(collection(
+                feature(R"({"type": "Point", "coordinates": [116.5, 39.5, 30.0]})", R"({"name": "ZBAA"})") + "," +
+                feature(R"({"type": "LineString", "coordinates": [[1, 2], [3, 4]]})",
+                        R"({"color": "#FF0000", "zoom": "7", "maxZoom": 12, "stroke": "dashed"})")));
+        ASSERT_EQ(result.mFeatures.size(), 2u);
+        const RenderData &text = result.mFeatures[0];
+        EXPECT_EQ(text.mType, RenderType::TEXT);
+        EXPECT_EQ(text.mText, "ZBAA");
+        ASSERT_EQ(text.mCoordinates.size(), 1u);
+        EXPECT_EQ(text.mCoordinates[0].mLongitude, 116.5);
+        EXPECT_EQ(text.mCoordinates[0].mLatitude, 39.5);
+
+        const RenderData &line = result.mFeatures[1];
+        EXPECT_EQ(line.mType, RenderType::LINE);
+        EXPECT_EQ(line.mRawColor, "#FF0000");
+        EXPECT_EQ(line.mZoom, 7);
+        EXPECT_EQ(line.mMaxZoom, 12);
+        EXPECT_EQ(line.mLineStyle, LineStyle::Dashed);
+        EXPECT_EQ(line.mCoordinates.size(), 2u);
+        EXPECT_TRUE(result.mErrors.empty());
+    }
+
+    TEST(GeoJsonReader, MultiGeometriesBecomeOneFeaturePerPart) {
+        const ReadResult result = read(collection(
+                feature(R"({"type": "MultiPoint", "coordinates": [[1, 1], [2, 2]]})", R"({"text": "P"})") + "," +
+                feature(R"({"type": "MultiLineString", "coordinates": [[[1, 1], [2, 2]], [[3, 3], [4, 4], [5, 5]]]})") +
+                "," +
+                feature(R"({"type": "MultiPolygon", "coordinates": [
+                        [[[0, 0], [1, 0], [1, 1], [0, 0]]],
+                        [[[5, 5], [6, 5], [6, 6], [5, 5]]]]})")));
+        ASSERT_EQ(result.mFeatures.size(), 6u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::TEXT);
+        EXPECT_EQ(result.mFeatures[1].mText, "P");
+        EXPECT_EQ(result.mFeatures[1].mCoordinates[0].mLongitude, 2.0);
+        EXPECT_EQ(result.mFeatures[2].mType, RenderType::LINE);
+        EXPECT_EQ(result.mFeatures[2].mCoordinates.size(), 2u);
+        EXPECT_EQ(result.mFeatures[3].mCoordinates.size(), 3u);
+        EXPECT_EQ(result.mFeatures[4].mType, RenderType::AREA);
+        EXPECT_EQ(result.mFeatures[5].mCoordinates[0].mLongitude, 5.0);
+    }
+
+    TEST(GeoJsonReader, PolygonsKeepOnlyTheOuterRing) {
+        const ReadResult result = read(collection(feature(R"({"type": "Polygon", "coordinates": [
+                [[0, 0], [10, 0], [10, 10], [0, 10], [0, 0]],
+                [[2, 2], [3, 2], [3, 3], [2, 2]]]})")));
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        const Coordinates &ring = result.mFeatures[0].mCoordinates;
+        // the repeated closing position is dropped as well
+        ASSERT_EQ(ring.size(), 4u);
+        EXPECT_EQ(ring[2].mLongitude, 10.0);
+        EXPECT_EQ(ring[3].mLatitude, 10.0);
+    }
+
+    TEST(GeoJsonReader, SkipsNullAndUnsupportedGeometries) {
+        const ReadResult result = read(collection(
+                feature("null") + "," +
+                feature(R"({"type": "GeometryCollection", "geometries": []})") + "," +
+                feature(R"({"type": "Point", "coordinates": [1, 2]})")));
+        EXPECT_EQ(result.mFeatures.size(), 1u);
+        EXPECT_EQ(result.mSkippedFeatures, 2u);
+        EXPECT_TRUE(result.mErrors.empty());
+    }
+
+    TEST(GeoJsonReader, ReportsColorTable) {
+        const ReadResult result = read(R"({"type": "FeatureCollection", "color": {"red": "#FF0000"}, "features": []})");
+        ASSERT_EQ(result.mColors.size(), 1u);
+        EXPECT_EQ(result.mColors[0], (std::pair<std::string, std::string>{"red", "#FF0000"}));
+    }
+
+    TEST(GeoJsonReader, DropsInvalidPositionsAndKeepsLoading) {
+        const ReadResult result = read(
+                "{\"type\": \"FeatureCollection\", \"features\": [\n" +
+                feature(R"({"type": "LineString", "coordinates": [[1], [2, 3], [4, 5]]})") + ",\n" +
+                feature(R"({"type": "LineString", "coordinates": [[1e999, 0], [2, 3], ["4", 5], [null, 1], [6, 7]]})") +
+                "\n]}");
+        ASSERT_EQ(result.mFeatures.size(), 2u);
+        ASSERT_EQ(result.mFeatures[0].mCoordinates.size(), 2u);
+        EXPECT_EQ(result.mFeatures[0].mCoordinates[0].mLongitude, 2.0);
+        ASSERT_EQ(result.mFeatures[1].mCoordinates.size(), 2u);
+        EXPECT_EQ(result.mFeatures[1].mCoordinates[1].mLongitude, 6.0);
+        ASSERT_EQ(result.mErrors.size(), 4u);
+        EXPECT_EQ(result.mErrors[0].mLine, 2u);
+        EXPECT_NE(result.mErrors[0].mMessage.find("longitude and a latitude"), std::string::npos);
+        EXPECT_EQ(result.mErrors[1].mLine, 3u);
+        EXPECT_NE(result.mErrors[1].mMessage.find("finite number"), std::string::npos);
+    }
+
+    TEST(GeoJsonReader, IgnoresInvalidNumericPropertiesAndMismatchedGeometries) {
+        const ReadResult result = read(collection(
+                feature(R"({"type": "LineString", "coordinates": [[1, 2], [3, 4]]})",
+                        R"({"zoom": "high", "strokeWidth": 1e999, "size": 14})") + "," +
+                feature(R"({"type": "Polygon", "coordinates": [[1, 2], [3, 4]]})")));
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        EXPECT_EQ(result.mFeatures[0].mZoom, 0);
+        EXPECT_EQ(result.mFeatures[0].mStrokeWidth, 0.0f);
+        EXPECT_EQ(result.mFeatures[0].mFontSize, 14);
+        EXPECT_EQ(result.mSkippedFeatures, 1u);
+        ASSERT_EQ(result.mErrors.size(), 3u);
+        EXPECT_NE(result.mErrors[0].mMessage.find("'zoom'"), std::string::npos);
+        EXPECT_NE(result.mErrors[1].mMessage.find("'strokeWidth'"), std::string::npos);
+        EXPECT_NE(result.mErrors[2].mMessage.find("'Polygon'"), std::string::npos);
+    }
+
+    TEST(GeoJsonReader, MalformedDocumentsStillFail) {
+        EXPECT_THROW(read("[]"), JsonParseError);
+        EXPECT_THROW(read(R"({"type": "Feature", "features": []})"), JsonParseError);
+        EXPECT_THROW(read(collection("1")), JsonParseError);
+        EXPECT_THROW(read(collection(feature(R"({"type": "LineString", "coordinates": [[1, 2], 3]})"))),
+                     JsonParseError);
+        EXPECT_THROW(read(collection(feature(R"({"type": "LineString", "coordinates": [[1, 2], [3, 4])"))),
+                     JsonParseError);
+    }
+
+    TEST(GeoJsonProvider, ReadsAgainWhenTheColorTableFollowsTheFeatures) {
+        const fs::path path = fs::temp_directory_path() / "erp_geojson_trailing_color.geojson";
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+                << "{\"type\": \"FeatureCollection\", \"features\": [" +
+                   feature(R"({"type": "LineString", "coordinates": [[1, 2], [3, 4]]})", R"({"color": "green"})") +
+                   "], \"color\": {\"green\": \"#00FF00\"}}";
+        RenderDataGeoJsonProvider provider;
+        ASSERT_TRUE(provider.loadData(path));
+        const FeatureStorePtr store = provider.getFeatureStore();
+        ASSERT_EQ(store->size(), 1u);
+        // the first read did not know the name yet, the second one resolved it
+        EXPECT_EQ(store->palette()[store->style(0).mColor], Color(0, 255, 0));
+        EXPECT_TRUE(provider.getLoadErrors().empty());
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+
+    TEST(GeoJsonProvider, CollectsDataErrors) {
+        const fs::path path = fs::temp_directory_path() / "erp_geojson_data_errors.geojson";
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+                << collection(feature(R"({"type": "LineString", "coordinates": [[1], [2, 3], [4, 5]]})"));
+        RenderDataGeoJsonProvider provider;
+        ASSERT_TRUE(provider.loadData(path));
+        EXPECT_EQ(provider.getFeatureStore()->size(), 1u);
+        EXPECT_EQ(provider.getLoadErrors().size(), 1u);
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+}
@@ -0,0 +1,271 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "render_data_sector_provider.h"
+#include "render_data_sector_reader.h"
+
+namespace RenderPlugin {
+    namespace {
+        struct ReadResult {
+            std::vector<std::pair<std::string, std::string>> mColors;
+            std::vector<RenderData> mFeatures;
+            size_t mSkippedLines{0};
+            size_t mLateColorCount{0};
+        };
+
+        ReadResult read(SectorFileFormat format, std::string_view text) {
+            ReadResult result;
+            SectorFileReader reader(format, {
+                    [&result](const std::string &name, const std::string &value) {
+                        result.mColors.emplace_back(name, value);
+                    },
+                    [&result](RenderData &&data) { result.mFeatures.push_back(std::move(data)); }
+            });
+            reader.read(text);
+            result.mSkippedLines = reader.skippedLines();
+            result.mLateColorCount = reader.lateColorCount();
+            return result;
+        }
+
+        double latitude(std::string_view text) {
+            double degrees = 0.0;
+            EXPECT_TRUE(parseSectorCoordinate(text, true, degrees)) << text;
+            return degrees;
+        }
+
+        double longitude(std::string_view text) {
+            double degrees = 0.0;
+            EXPECT_TRUE(parseSectorCoordinate(text, false, degrees)) << text;
+            return degrees;
+        }
+    }
+
+    TEST(SectorCoordinate, ParsesDegreesMinutesSeconds) {
+        EXPECT_DOUBLE_EQ(latitude("N039.54.00.000"), 39.9);
+        EXPECT_DOUBLE_EQ(latitude("S033.56.24.000"), -(33.0 + 56.0 / 60.0 + 24.0 / 3600.0));
+        EXPECT_DOUBLE_EQ(longitude("E116.23.30.500"), 116.0 + 23.0 / 60.0 + 30.5 / 3600.0);
+        EXPECT_DOUBLE_EQ(longitude("w000.30.00"), -0.5);
+        EXPECT_DOUBLE_EQ(latitude(" N090.00.00.000\r"), 90.0);
+        EXPECT_DOUBLE_EQ(longitude("E180.00.00.000"), 180.0);
+    }
+
+    TEST(SectorCoordinate, RejectsOutOfRangeAndMalformedValues) {
+        double degrees = 0.0;
+        // minutes and seconds are below 60
+        EXPECT_FALSE(parseSectorCoordinate("N039.60.00.000", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N039.54.60.000", true, degrees));
+        EXPECT_TRUE(parseSectorCoordinate("N039.54.59.999", true, degrees));
+        // the hemisphere letter must match the axis
+        EXPECT_FALSE(parseSectorCoordinate("E039.54.00.000", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("S039.54.00.000", false, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N116.23.00.000", false, degrees));
+        // beyond the poles or the antimeridian
+        EXPECT_FALSE(parseSectorCoordinate("N090.00.00.001", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("S091.00.00.000", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("E180.00.01.000", false, degrees));
+
+        EXPECT_FALSE(parseSectorCoordinate("", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("X039.54.00.000", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N-39.54.00.000", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N039.54", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("N039.54.00.000X", true, degrees));
+        EXPECT_FALSE(parseSectorCoordinate("PEK", true, degrees));
+    }
+
+    TEST(SectorColor, ConvertsBgrIntegersToHex) {
+        std::string color;
+        ASSERT_TRUE(parseSectorColor("255", color));
+        EXPECT_EQ(color, "#FF0000");
+        ASSERT_TRUE(parseSectorColor("65280", color));
+        EXPECT_EQ(color, "#00FF00");
+        ASSERT_TRUE(parseSectorColor("16711680", color));
+        EXPECT_EQ(color, "#0000FF");
+        ASSERT_TRUE(parseSectorColor(" 9076039 ", color));
+        EXPECT_EQ(color, "#477D8A");
+        ASSERT_TRUE(parseSectorColor("0", color));
+        EXPECT_EQ(color, "#000000");
+
+        EXPECT_FALSE(parseSectorColor("", color));
+        EXPECT_FALSE(parseSectorColor("-1", color));
+        EXPECT_FALSE(parseSectorColor("16777216", color));
+        EXPECT_FALSE(parseSectorColor("coast", color));
+        EXPECT_FALSE(parseSectorColor("255x", color));
+    }
+
+    TEST(SectorFileReader, DefinesReportColors) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "#define coast 9076039\n"
+                                       "#define bad blue\n"
+                                       "#define\tsid   255 ; comment\n");
+        ASSERT_EQ(result.mColors.size(), 2u);
+        EXPECT_EQ(result.mColors[0], (std::pair<std::string, std::string>{"coast", "#477D8A"}));
+        EXPECT_EQ(result.mColors[1], (std::pair<std::string, std::string>{"sid", "#FF0000"}));
+        EXPECT_EQ(result.mSkippedLines, 1u);
+        EXPECT_EQ(result.mLateColorCount, 0u);
+    }
+
+    TEST(SectorFileReader, MergesConnectedSegmentsOfTheSameColor) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "[GEO]\n"
+                                       "Coast N030.00.00.000 E120.00.00.000 N030.00.00.000 E121.00.00.000 coast\n"
+                                       "Coast N030.00.00.000 E121.00.00.000 N031.00.00.000 E121.00.00.000 coast\n"
+                                       // same end point, other color
+                                       "N031.00.00.000 E121.00.00.000 N031.00.00.000 E122.00.00.000 255\n"
+                                       // same color, not connected
+                                       "N032.00.00.000 E122.00.00.000 N032.00.00.000 E123.00.00.000 255\n"
+                                       "N032.00.00.000 E123.00.00.000 N032.00.00.000\n");
+        ASSERT_EQ(result.mFeatures.size(), 3u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::LINE);
+        EXPECT_EQ(result.mFeatures[0].mRawColor, "coast");
+        ASSERT_EQ(result.mFeatures[0].mCoordinates.size(), 3u);
+        EXPECT_DOUBLE_EQ(result.mFeatures[0].mCoordinates[2].mLatitude, 31.0);
+        EXPECT_DOUBLE_EQ(result.mFeatures[0].mCoordinates[2].mLongitude, 121.0);
+        EXPECT_EQ(result.mFeatures[1].mRawColor, "#FF0000");
+        EXPECT_EQ(result.mFeatures[1].mCoordinates.size(), 2u);
+        EXPECT_EQ(result.mFeatures[2].mCoordinates.size(), 2u);
+        EXPECT_EQ(result.mSkippedLines, 1u);
+    }
+
+    TEST(SectorFileReader, SegmentsResolveNamedPoints) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "[VOR]\n"
+                                       "PEK 114.700 N040.00.00.000 E116.00.00.000\n"
+                                       "[FIXES]\n"
+                                       "ABBEY N041.00.00.000 E117.00.00.000\n"
+                                       "[ARTCC HIGH]\n"
+                                       "ZBPE PEK PEK ABBEY ABBEY\n"
+                                       "ZBPE PEK PEK NOWHERE NOWHERE\n");
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        const RenderData &line = result.mFeatures[0];
+        EXPECT_EQ(line.mRawColor, SECTOR_DEFAULT_COLOR);
+        ASSERT_EQ(line.mCoordinates.size(), 2u);
+        EXPECT_DOUBLE_EQ(line.mCoordinates[0].mLongitude, 116.0);
+        EXPECT_DOUBLE_EQ(line.mCoordinates[1].mLatitude, 41.0);
+        EXPECT_EQ(result.mSkippedLines, 1u);
+    }
+
+    TEST(SectorFileReader, RegionsContinueOnIndentedLines) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "[REGIONS]\n"
+                                       "REGIONNAME Apron\n"
+                                       "apron N030.00.00.000 E120.00.00.000\n"
+                                       "      N030.00.00.000 E120.00.01.000\n"
+                                       "\tN030.00.01.000 E120.00.01.000\n"
+                                       "REGIONNAME Grass\n"
+                                       "255 N031.00.00.000 E121.00.00.000\n"
+                                       "    N031.00.00.000 E121.00.01.000\n"
+                                       "    N031.00.01.000 E121.00.01.000\n"
+                                       "    N031.00.01.000 bad\n");
+        ASSERT_EQ(result.mFeatures.size(), 2u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::AREA);
+        EXPECT_EQ(result.mFeatures[0].mRawFill, "apron");
+        EXPECT_EQ(result.mFeatures[0].mRawColor, "apron");
+        EXPECT_EQ(result.mFeatures[0].mCoordinates.size(), 3u);
+        EXPECT_EQ(result.mFeatures[1].mRawFill, "#FF0000");
+        EXPECT_EQ(result.mFeatures[1].mCoordinates.size(), 3u);
+        EXPECT_EQ(result.mSkippedLines, 1u);
+    }
+
+    TEST(SectorFileReader, LabelsAreQuotedText) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "[LABELS]\n"
+                                       "\"Gate 12\" N030.00.00.000 E120.00.00.000 255\n"
+                                       "\"Tower\" N030.00.00.000 E120.00.00.000\n"
+                                       "Unquoted N030.00.00.000 E120.00.00.000\n");
+        ASSERT_EQ(result.mFeatures.size(), 2u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::TEXT);
+        EXPECT_EQ(result.mFeatures[0].mText, "Gate 12");
+        EXPECT_EQ(result.mFeatures[0].mRawColor, "#FF0000");
+        EXPECT_EQ(result.mFeatures[1].mRawColor, SECTOR_DEFAULT_COLOR);
+        EXPECT_EQ(result.mSkippedLines, 1u);
+    }
+
+    TEST(SectorFileReader, EseSectorLinesCollectCoordinates) {
+        const ReadResult result = read(SectorFileFormat::Ese,
+                                       "[AIRSPACE]\n"
+                                       "SECTORLINE:ZBPE_1\n"
+                                       "DISPLAY:ZBPE:ZBPE:ZBAA\n"
+                                       "COORD:N040.00.00.000:E116.00.00.000\n"
+                                       "COORD:N041.00.00.000:E117.00.00.000\n"
+                                       "COORD:N041.00.00.000\n"
+                                       "SECTOR:ZBPE:0:300\n"
+                                       "OWNER:PEK\n"
+                                       "COORD:N042.00.00.000:E118.00.00.000\n");
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::LINE);
+        EXPECT_EQ(result.mFeatures[0].mCoordinates.size(), 2u);
+        // the malformed COORD and the one that follows no SECTORLINE
+        EXPECT_EQ(result.mSkippedLines, 2u);
+    }
+
+    TEST(SectorFileReader, CircleSectorLinesTakeACoordinateOrAKnownPoint) {
+        const ReadResult result = read(SectorFileFormat::Ese,
+                                       "[AIRSPACE]\n"
+                                       "CIRCLE_SECTORLINE:ZBAA_CTR:N040.00.00.000:E116.00.00.000:30\n"
+                                       // an .ese file defines no points, a named center is never known
+                                       "CIRCLE_SECTORLINE:ZBAA_APP:PEK:30\n"
+                                       "CIRCLE_SECTORLINE:ZBAA_TWR:N040.00.00.000:E116.00.00.000:0\n"
+                                       "CIRCLE_SECTORLINE:ZBAA_GND:N040.00.00.000:E116.00.00.000:far\n");
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        const Coordinates &circle = result.mFeatures[0].mCoordinates;
+        ASSERT_EQ(circle.size(), 73u);
+        EXPECT_DOUBLE_EQ(circle.front().mLongitude, circle.back().mLongitude);
+        EXPECT_DOUBLE_EQ(circle.front().mLatitude, circle.back().mLatitude);
+        // 30 nm north of the center is half a degree
+        EXPECT_DOUBLE_EQ(circle.front().mLatitude, 40.5);
+        EXPECT_DOUBLE_EQ(circle.front().mLongitude, 116.0);
+        EXPECT_EQ(result.mSkippedLines, 3u);
+    }
+
+    TEST(SectorFileReader, FreeTextKeepsColonsInTheText) {
+        const ReadResult result = read(SectorFileFormat::Ese,
+                                       "[FREETEXT]\n"
+                                       "N040.00.00.000:E116.00.00.000:Gates:Gate 1:2\n"
+                                       "N040.00.00.000:E116.00.00.000:Gates\n");
+        ASSERT_EQ(result.mFeatures.size(), 1u);
+        EXPECT_EQ(result.mFeatures[0].mType, RenderType::TEXT);
+        EXPECT_EQ(result.mFeatures[0].mText, "Gate 1:2");
+        EXPECT_EQ(result.mFeatures[0].mRawColor, SECTOR_DEFAULT_COLOR);
+        EXPECT_EQ(result.mSkippedLines, 1u);
+    }
+
+    TEST(SectorFileReader, CountsDefinesAfterTheFirstFeature) {
+        const ReadResult result = read(SectorFileFormat::Sct,
+                                       "#define early 255\n"
+                                       "[GEO]\n"
+                                       "N030.00.00.000 E120.00.00.000 N030.00.00.000 E121.00.00.000 early\n"
+                                       "#define pending 255\n"
+                                       // the unconnected segment emits the first line
+                                       "N031.00.00.000 E120.00.00.000 N031.00.00.000 E121.00.00.000 late\n"
+                                       "#define late 65280\n");
+        // a line still being merged has not been emitted, colors defined before it ends are not late
+        EXPECT_EQ(result.mLateColorCount, 1u);
+        EXPECT_EQ(result.mColors.size(), 3u);
+        EXPECT_EQ(result.mFeatures.size(), 2u);
+    }
+
+    TEST(SectorProvider, ReadsAgainWhenColorsAreDefinedLate) {
+        const fs::path path = fs::temp_directory_path() / "erp_sector_late_define.sct";
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+                << "[LABELS]\n"
+                   "\"Tower\" N030.00.00.000 E120.00.00.000 late\n"
+                   "#define late 65280\n";
+        RenderDataSectorProvider provider;
+        ASSERT_TRUE(provider.loadData(path));
+        const FeatureStorePtr store = provider.getFeatureStore();
+        ASSERT_EQ(store->size(), 1u);
+        // the first read did not know the name yet, the second one resolved it
+        EXPECT_EQ(store->palette()[store->style(0).mColor], Color(0, 255, 0));
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "render_data_yaml_chunks.h"
+
+namespace RenderPlugin {
+    namespace {
+        constexpr std::string_view DOCUMENT =
+                "color:\n"
+                "  red: \"#FF0000\"\n"
+                "features:\n"
+                "  - type: line\n"
+                "    coordinates:\n"
+                "      - [1, 2]\n"
+                "      - [3, 4]\n"
+                "\n"
+                "  # second feature\n"
+                "  - type: text\n"
+                "    text: A\n"
+                "include:\n"
+                "  - other.yaml\n";
+    }
+
+    TEST(YamlFeatureChunks, SplitsAtFeatureBoundaries) {
+        YamlFeatureSplit split;
+        ASSERT_TRUE(splitYamlFeatures(DOCUMENT, split));
+        ASSERT_EQ(split.mItems.size(), 2u);
+        EXPECT_EQ(split.mItems[0].mText, "  - type: line\n    coordinates:\n      - [1, 2]\n      - [3, 4]\n\n"
+                                         "  # second feature\n");
+        EXPECT_EQ(split.mItems[0].mFirstLine, 3u);
+        EXPECT_EQ(split.mItems[1].mText, "  - type: text\n    text: A\n");
+        EXPECT_EQ(split.mItems[1].mFirstLine, 9u);
+        // the rest keeps the color table, the features key and the keys after the sequence
+        EXPECT_EQ(split.mRest, "color:\n  red: \"#FF0000\"\nfeatures:\ninclude:\n  - other.yaml\n");
+    }
+
+    TEST(YamlFeatureChunks, ItemsAreContiguousViewsIntoTheSource) {
+        YamlFeatureSplit split;
+        ASSERT_TRUE(splitYamlFeatures(DOCUMENT, split));
+        EXPECT_EQ(split.mItems[0].mText.data() + split.mItems[0].mText.size(), split.mItems[1].mText.data());
+        EXPECT_GE(split.mItems[0].mText.data(), DOCUMENT.data());
+    }
+
+    TEST(YamlFeatureChunks, RejectsLayoutsThatCannotBeSplitSafely) {
+        YamlFeatureSplit split;
+        EXPECT_FALSE(splitYamlFeatures("features: [{type: line}]\n", split));
+        EXPECT_FALSE(splitYamlFeatures("features:\n\t- type: line\n", split));
+        EXPECT_FALSE(splitYamlFeatures("color:\n  red: \"#FF0000\"\n", split));
+        EXPECT_FALSE(splitYamlFeatures("features:\n  type: line\n", split));
+    }
+
+    TEST(YamlFeatureChunks, GroupsUpToTheTargetSize) {
+        YamlFeatureSplit split;
+        ASSERT_TRUE(splitYamlFeatures(DOCUMENT, split));
+        const size_t firstSize = split.mItems[0].mText.size();
+
+        std::vector<YamlFeatureChunk> chunks;
+        groupYamlFeatures(split.mItems, 0, split.mItems.size(), 1 << 20, chunks);
+        ASSERT_EQ(chunks.size(), 1u);
+        EXPECT_EQ(chunks[0].mFeatureCount, 2u);
+        EXPECT_EQ(chunks[0].mFirstLine, 3u);
+        EXPECT_EQ(chunks[0].mText.size(), firstSize + split.mItems[1].mText.size());
+
+        // a target smaller than one item still puts every item into exactly one chunk
+        chunks.clear();
+        groupYamlFeatures(split.mItems, 0, split.mItems.size(), 1, chunks);
+        ASSERT_EQ(chunks.size(), 2u);
+        EXPECT_EQ(chunks[1].mText, split.mItems[1].mText);
+        EXPECT_EQ(chunks[1].mFirstLine, 9u);
+
+        chunks.clear();
+        groupYamlFeatures(split.mItems, 1, 1, 1 << 20, chunks);
+        EXPECT_TRUE(chunks.empty());
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "render_data_yaml_provider.h"
+
+namespace RenderPlugin {
+    namespace {
+        constexpr std::string_view COLORS = "color:\n"
+                                            "  red: \"#FF0000\"\n"
+                                            "features:\n";
+
+        constexpr std::string_view CLEAN = "  - type: line\n"
+                                           "    color: red\n"
+                                           "    coordinates:\n"
+                                           "      - [120.0, 30.0]\n"
+                                           "      - [121.0, 31.0]\n";
+
+        // kept, the zoom is ignored
+        constexpr std::string_view WITH_ERROR = "  - type: line\n"
+                                                "    color: red\n"
+                                                "    zoom: high\n"
+                                                "    coordinates:\n"
+                                                "      - [122.0, 32.0]\n"
+                                                "      - [123.0, 33.0]\n";
+
+        // skipped, the type is missing
+        constexpr std::string_view SKIPPED = "  - color: red\n"
+                                             "    coordinates:\n"
+                                             "      - [124.0, 34.0]\n"
+                                             "      - [125.0, 35.0]\n";
+
+        constexpr std::string_view EDITED = "  - type: line\n"
+                                            "    color: red\n"
+                                            "    coordinates:\n"
+                                            "      - [125.0, 35.0]\n"
+                                            "      - [126.0, 36.0]\n";
+
+        class YamlProviderTest : public testing::Test {
+        protected:
+            fs::path mPath;
+
+            void SetUp() override {
+                mPath = fs::temp_directory_path() /
+                        ("erp_yaml_provider_" +
+                         std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".yaml");
+            }
+
+            void TearDown() override {
+                std::error_code ec;
+                fs::remove(mPath, ec);
+            }
+
+            void write(std::string_view text) const {
+                std::ofstream(mPath, std::ios::binary | std::ios::trunc) << text;
+            }
+
+            [[nodiscard]] std::shared_ptr<RenderDataYamlProvider> load(FeatureStorePtr previous = nullptr) const {
+                auto provider = std::make_shared<RenderDataYamlProvider>();
+                provider->setLoadMode(YamlLoadMode::Parallel);
+                provider->setWorkerCount(1);
+                provider->setPreviousData(std::move(previous));
+                EXPECT_TRUE(provider->loadData(mPath));
+                return provider;
+            }
+        };
+    }
+
+    TEST_F(YamlProviderTest, ParallelLoadKeepsSourceHashesWhenFeaturesAreSkipped) {
+        write(std::string(COLORS) + std::string(CLEAN) + std::string(SKIPPED) + std::string(WITH_ERROR));
+        auto provider = load();
+        const FeatureStorePtr store = provider->getFeatureStore();
+        ASSERT_EQ(store->size(), 2u);
+        ASSERT_EQ(store->sourceHashes().size(), 2u);
+        EXPECT_NE(store->sourceHashes()[0], 0u);
+        // a feature with errors is never reused, so that its errors are reported on every load
+        EXPECT_EQ(store->sourceHashes()[1], 0u);
+        EXPECT_EQ(store->zoom(1), 0);
+        EXPECT_EQ(provider->getLoadErrors().size(), 2u);
+    }
+
+    TEST_F(YamlProviderTest, ReloadReportsErrorsOfUnchangedFeaturesAtTheirNewLines) {
+        write(std::string(COLORS) + std::string(CLEAN) + std::string(SKIPPED) + std::string(WITH_ERROR));
+        const auto first = load();
+        const std::vector<DecodeError> firstErrors = first->getLoadErrors();
+        ASSERT_EQ(firstErrors.size(), 2u);
+
+        write(std::string(COLORS) + std::string(EDITED) + std::string(CLEAN) + std::string(SKIPPED) +
+              std::string(WITH_ERROR));
+        const auto second = load(first->getFeatureStore());
+        const FeatureStorePtr store = second->getFeatureStore();
+        ASSERT_EQ(store->size(), 3u);
+        ASSERT_EQ(store->sourceHashes().size(), 3u);
+        EXPECT_EQ(store->sourceHashes()[1], first->getFeatureStore()->sourceHashes()[0]);
+        EXPECT_EQ(store->coordinates(0)[0].mLongitude, 125.0);
+
+        const std::vector<DecodeError> &errors = second->getLoadErrors();
+        ASSERT_EQ(errors.size(), 2u);
+        const size_t shift = 5;
+        EXPECT_EQ(errors[0].mLine, firstErrors[0].mLine + shift);
+        EXPECT_EQ(errors[1].mLine, firstErrors[1].mLine + shift);
+    }
+
+    TEST_F(YamlProviderTest, CacheThatCannotBeReplacedIsANoticeNotALoadError) {
+        write(std::string(COLORS) + std::string(CLEAN));
+        // the rename over the cache fails, as it does on Windows while another instance maps the old cache
+        const fs::path cachePath = RenderDataProvider::binaryCachePath(mPath);
+        fs::create_directories(cachePath / "in-use");
+
+        auto provider = std::make_shared<RenderDataYamlProvider>();
+        provider->setBinaryCacheEnabled(true);
+        ASSERT_TRUE(provider->loadData(mPath));
+        EXPECT_EQ(provider->getFeatureStore()->size(), 1u);
+        EXPECT_TRUE(provider->getLoadErrors().empty());
+        ASSERT_EQ(provider->getLoadNotices().size(), 1u);
+        EXPECT_NE(provider->getLoadNotices()[0].find(cachePath.string()), std::string::npos);
+
+        // no temporary file is left next to the cache
+        size_t files = 0;
+        for (const auto &entry: fs::directory_iterator(mPath.parent_path())) {
+            files += entry.path().filename().string().starts_with(cachePath.filename().string()) ? 1 : 0;
+        }
+        EXPECT_EQ(files, 1u);
+        fs::remove_all(cachePath);
+    }
+}
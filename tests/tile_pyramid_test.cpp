@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "geometry_utils.h"
+#include "render_data_definition.hpp"
+#include "tile_pyramid.h"
+
+namespace RenderPlugin {
+    namespace {
+        struct Features {
+            std::vector<GeoRect> mBounds;
+            std::vector<uint8_t> mMinZooms;
+            std::vector<uint8_t> mMaxZooms;
+        };
+
+        Features randomFeatures(size_t count) {
+            std::mt19937 random(42);
+            std::uniform_real_distribution<double> longitude(-179.0, 179.0);
+            std::uniform_real_distribution<double> latitude(-80.0, 80.0);
+            // mostly small features, some spanning tens of degrees
+            std::exponential_distribution<double> span(2.0);
+            std::uniform_int_distribution<int> zoom(0, 14);
+            Features features;
+            for (size_t i = 0; i < count; ++i) {
+                const double lon = longitude(random);
+                const double lat = latitude(random);
+                const double size = span(random) * (i % 50 == 0 ? 20.0 : 1.0);
+                features.mBounds.push_back({lon, lat, lon + size, lat + size / 2.0});
+                const int minZoom = i % 3 == 0 ? 0 : zoom(random);
+                features.mMinZooms.push_back(static_cast<uint8_t>(minZoom));
+                features.mMaxZooms.push_back(i % 4 == 0 ? static_cast<uint8_t>(minZoom + 3) : 0);
+            }
+            // a feature without coordinates is never returned
+            features.mBounds.push_back(GeoRect());
+            features.mMinZooms.push_back(0);
+            features.mMaxZooms.push_back(0);
+            return features;
+        }
+
+        std::vector<uint32_t> scan(const Features &features, const GeoRect &rect, int zoom) {
+            std::vector<uint32_t> out;
+            for (size_t i = 0; i < features.mBounds.size(); ++i) {
+                if (isZoomVisible(zoom, features.mMinZooms[i], features.mMaxZooms[i]) &&
+                    geoRectsIntersect(features.mBounds[i], rect)) {
+                    out.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            return out;
+        }
+    }
+
+    TEST(TilePyramid, QueryMatchesScanInDrawOrder) {
+        const Features features = randomFeatures(5000);
+        TilePyramid pyramid;
+        pyramid.build(features.mBounds, features.mMinZooms, features.mMaxZooms);
+        ASSERT_FALSE(pyramid.empty());
+        EXPECT_TRUE(pyramid.valid(features.mBounds.size()));
+
+        const GeoRect views[] = {
+                {116.0, 39.5, 116.5, 40.0},
+                {100.0, 20.0, 120.0, 40.0},
+                {-180.0, -90.0, 180.0, 90.0},
+                {170.0, -10.0, 180.0, 10.0},
+        };
+        for (const auto &view: views) {
+            for (int zoom: {0, 3, 7, 12, 19}) {
+                std::vector<uint32_t> out;
+                pyramid.query(view, zoom, features.mBounds, features.mMinZooms, features.mMaxZooms, out);
+                EXPECT_EQ(out, scan(features, view, zoom)) << view.mMinLongitude << " zoom " << zoom;
+            }
+        }
+    }
+
+    TEST(TilePyramid, EmptyPyramidScansAllFeatures) {
+        const Features features = randomFeatures(100);
+        TilePyramid pyramid;
+        EXPECT_TRUE(pyramid.valid(features.mBounds.size()));
+        const GeoRect view{0.0, 0.0, 60.0, 60.0};
+        std::vector<uint32_t> out;
+        pyramid.query(view, 5, features.mBounds, features.mMinZooms, features.mMaxZooms, out);
+        EXPECT_EQ(out, scan(features, view, 5));
+    }
+
+    TEST(TilePyramid, ValidRejectsItemsOutOfRange) {
+        const Features features = randomFeatures(100);
+        TilePyramid pyramid;
+        pyramid.build(features.mBounds, features.mMinZooms, features.mMaxZooms);
+        EXPECT_TRUE(pyramid.valid(features.mBounds.size()));
+        EXPECT_FALSE(pyramid.valid(10));
+    }
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include "zoom_utils.h"
+
+namespace RenderPlugin {
+    TEST(ZoomUtils, SpanIsTheLargerAbsoluteSpan) {
+        EXPECT_DOUBLE_EQ(getSpanDeg(100.0, 30.0, 102.0, 31.0), 2.0);
+        EXPECT_DOUBLE_EQ(getSpanDeg(100.0, 30.0, 101.0, 34.0), 4.0);
+        EXPECT_DOUBLE_EQ(getSpanDeg(102.0, 31.0, 100.0, 30.0), 2.0);
+        EXPECT_DOUBLE_EQ(getSpanDeg(100.0, 30.0, 100.0, 30.0), 0.0);
+    }
+
+    TEST(ZoomUtils, SpanToZoomLevel) {
+        EXPECT_EQ(spanDegToZoomLevel(360.0 / 512.0), 9);
+        EXPECT_EQ(spanDegToZoomLevel(360.0 / 128.0), 7);
+        // rounded to the nearest level
+        EXPECT_EQ(spanDegToZoomLevel(360.0 / 600.0), 9);
+        EXPECT_EQ(spanDegToZoomLevel(360.0 / 800.0), 10);
+    }
+
+    TEST(ZoomUtils, ZoomLevelIsClamped) {
+        EXPECT_EQ(spanDegToZoomLevel(0.0), MAX_ZOOM_LEVEL);
+        EXPECT_EQ(spanDegToZoomLevel(1e-9), MAX_ZOOM_LEVEL);
+        EXPECT_EQ(spanDegToZoomLevel(360.0), MIN_ZOOM_LEVEL);
+        EXPECT_EQ(spanDegToZoomLevel(10000.0), MIN_ZOOM_LEVEL);
+    }
+}
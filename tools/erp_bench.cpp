@@ -0,0 +1,558 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+// 数据集加载基准：比较流式、并行、DOM、二进制缓存、增量重新加载和 GeoJSON 的耗时，并校验各方式得到的要素存储一致
+//
+//   erp-bench <data.yaml> [iterations] [--mode stream|parallel|dom|cache|reload|geojson|query|all] [--threads N]
+//
+// cache 方式先删除已有的 .erpbin，首轮解析并写入缓存，之后各轮直接映射缓存；
+// reload 方式在第一个要素后插入一行注释（相当于修改了一个要素）写到临时文件，以原数据集为基准增量加载；
+// geojson 方式将数据集导出为等价的 GeoJSON 临时文件后测量其加载耗时；
+// query 方式在随机视野及其缩放等级下比较逐个检查缩放等级和包围盒与瓦片金字塔查询的耗时，并校验两者结果一致
+//   erp-bench --generate <out.yaml> <featureCount>
+//
+// 数据文件为 EuroScope 扇区文件（.sct / .sct2 / .ese）时只测量扇区文件的加载耗时
+//   erp-bench <sector.sct|sector.ese> [iterations]
+//   erp-bench --generate-sector <out.sct|out.ese> <lineCount>
+//
+// 单独测量峰值内存时使用 --mode 分别运行各方式，配合系统工具（如 /usr/bin/time -v）
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "geometry_utils.h"
+#include "mapped_file.h"
+#include "render_data_geojson_provider.h"
+#include "render_data_sector_provider.h"
+#include "render_data_yaml_chunks.h"
+#include "render_data_yaml_provider.h"
+#include "string_utils.h"
+#include "zoom_utils.h"
+
+namespace {
+    using namespace RenderPlugin;
+
+    struct BenchResult {
+        std::vector<double> mMilliseconds;
+        FeatureStorePtr mStore;
+    };
+
+    BenchResult runBench(const fs::path &path, YamlLoadMode mode, int iterations, size_t threads, bool cache) {
+        BenchResult result;
+        for (int i = 0; i < iterations; ++i) {
+            RenderDataYamlProvider provider;
+            provider.setLoadMode(mode);
+            provider.setWorkerCount(threads);
+            provider.setBinaryCacheEnabled(cache);
+            const auto start = std::chrono::steady_clock::now();
+            if (!provider.loadData(path)) {
+                throw std::runtime_error("failed to load " + path.string());
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result.mMilliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            result.mStore = provider.getFeatureStore();
+        }
+        return result;
+    }
+
+    /** 复制数据文件并修改其中第一个要素的源文本 */
+    void writeEditedCopy(const fs::path &source, const fs::path &target) {
+        auto file = MappedFile::open(source);
+        YamlFeatureSplit split;
+        if (!file || !splitYamlFeatures(file->view(), split)) {
+            throw std::runtime_error("cannot split " + source.string());
+        }
+        const std::string_view text = file->view();
+        const auto &first = split.mItems.front().mText;
+        const size_t insertAt = static_cast<size_t>(first.data() - text.data()) + first.size();
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        out.write(text.data(), static_cast<std::streamsize>(insertAt));
+        out << "    # edited\n";
+        out.write(text.data() + insertAt, static_cast<std::streamsize>(text.size() - insertAt));
+        if (!out.flush()) {
+            throw std::runtime_error("cannot write " + target.string());
+        }
+    }
+
+    BenchResult runReloadBench(const fs::path &path, const fs::path &edited, int iterations, size_t threads) {
+        RenderDataYamlProvider base;
+        base.setLoadMode(YamlLoadMode::Parallel);
+        base.setWorkerCount(threads);
+        if (!base.loadData(path)) {
+            throw std::runtime_error("failed to load " + path.string());
+        }
+        BenchResult result;
+        for (int i = 0; i < iterations; ++i) {
+            RenderDataYamlProvider provider;
+            provider.setLoadMode(YamlLoadMode::Parallel);
+            provider.setWorkerCount(threads);
+            provider.setPreviousData(base.getFeatureStore());
+            const auto start = std::chrono::steady_clock::now();
+            if (!provider.loadData(edited)) {
+                throw std::runtime_error("failed to load " + edited.string());
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result.mMilliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            result.mStore = provider.getFeatureStore();
+        }
+        return result;
+    }
+
+    void writeJsonString(std::ostream &out, std::string_view text) {
+        out << '"';
+        for (char c: text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (c == '\n') {
+                out << "\\n";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out << fmt::format("\\u{:04x}", static_cast<int>(c));
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    /** 将存储导出为等价的 GeoJSON：颜色写为解析后的 #RRGGBBAA，区域按 GeoJSON 的要求首尾闭合 */
+    void writeGeoJson(const FeatureStore &store, const fs::path &target) {
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        auto color = [&store](PaletteIndex index) {
+            const Color &c = store.palette()[index];
+            return fmt::format("\"#{:02X}{:02X}{:02X}{:02X}\"", c.red, c.green, c.blue, c.alpha);
+        };
+        auto position = [](const Coordinate &c) { return fmt::format("[{},{}]", c.mLongitude, c.mLatitude); };
+        out << "{\"type\":\"FeatureCollection\",\"features\":[\n";
+        for (FeatureStore::FeatureIndex i = 0; i < store.size(); ++i) {
+            const auto coordinates = store.coordinates(i);
+            std::string geometry;
+            if (store.type(i) == RenderType::TEXT) {
+                geometry = "{\"type\":\"Point\",\"coordinates\":" + position(coordinates[0]) + "}";
+            } else {
+                const bool area = store.type(i) == RenderType::AREA;
+                geometry = area ? "{\"type\":\"Polygon\",\"coordinates\":[[" : "{\"type\":\"LineString\",\"coordinates\":[";
+                for (size_t k = 0; k < coordinates.size(); ++k) {
+                    geometry += (k > 0 ? "," : "") + position(coordinates[k]);
+                }
+                if (area) {
+                    geometry += "," + position(coordinates[0]) + "]";
+                }
+                geometry += "]}";
+            }
+            const auto &style = store.style(i);
+            out << (i > 0 ? ",\n" : "") << "{\"type\":\"Feature\",\"geometry\":" << geometry
+                << ",\"properties\":{\"zoom\":" << static_cast<int>(store.zoom(i));
+            if (store.maxZoom(i) > 0) {
+                out << ",\"maxZoom\":" << store.maxZoom(i);
+            }
+            if (style.mFill != Palette::DEFAULT_INDEX) {
+                out << ",\"fill\":" << color(style.mFill);
+            }
+            if (style.mHasColor || style.mColor != Palette::DEFAULT_INDEX) {
+                out << ",\"color\":" << color(style.mColor);
+            }
+            if (!store.text(i).empty()) {
+                out << ",\"text\":";
+                writeJsonString(out, WstringToUtf8(std::wstring(store.text(i))));
+            }
+            out << fmt::format(",\"size\":{},\"textAnchor\":\"{}\",\"stroke\":\"{}\",\"strokeWidth\":{}"
+                               ",\"dash\":[{},{}]}}}}", style.mFontSize, textAnchorToString(style.mTextAnchor),
+                               lineStyleToString(style.mLineStyle), style.mStrokeWidth, style.mDashLength,
+                               style.mGapLength);
+        }
+        out << "\n]}\n";
+        if (!out.flush()) {
+            throw std::runtime_error("cannot write " + target.string());
+        }
+    }
+
+    BenchResult runGeoJsonBench(const fs::path &path, int iterations) {
+        BenchResult result;
+        for (int i = 0; i < iterations; ++i) {
+            RenderDataGeoJsonProvider provider;
+            const auto start = std::chrono::steady_clock::now();
+            if (!provider.loadData(path)) {
+                throw std::runtime_error("failed to load " + path.string());
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result.mMilliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            result.mStore = provider.getFeatureStore();
+        }
+        return result;
+    }
+
+    BenchResult runSectorBench(const fs::path &path, int iterations) {
+        BenchResult result;
+        for (int i = 0; i < iterations; ++i) {
+            RenderDataSectorProvider provider;
+            const auto start = std::chrono::steady_clock::now();
+            if (!provider.loadData(path)) {
+                throw std::runtime_error("failed to load " + path.string());
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result.mMilliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            result.mStore = provider.getFeatureStore();
+        }
+        return result;
+    }
+
+    void printResult(const std::string &name, const BenchResult &result) {
+        const auto &ms = result.mMilliseconds;
+        double total = 0;
+        for (double v: ms) {
+            total += v;
+        }
+        fmt::print("{:<8} min {:>10.2f} ms   avg {:>10.2f} ms   features {}   coordinates {}   styles {}   colors {}\n",
+                   name, *std::min_element(ms.begin(), ms.end()), total / static_cast<double>(ms.size()),
+                   result.mStore->size(), result.mStore->coordinateCount(), result.mStore->styleCount(),
+                   result.mStore->palette().size());
+    }
+
+    bool sameStore(const FeatureStore &a, const FeatureStore &b) {
+        if (a.size() != b.size() || a.coordinateCount() != b.coordinateCount()) {
+            return false;
+        }
+        for (FeatureStore::FeatureIndex i = 0; i < a.size(); ++i) {
+            if (a.type(i) != b.type(i) || a.zoom(i) != b.zoom(i) || a.maxZoom(i) != b.maxZoom(i) ||
+                a.text(i) != b.text(i)) {
+                return false;
+            }
+            const auto &sa = a.style(i);
+            const auto &sb = b.style(i);
+            if (a.palette()[sa.mFill] != b.palette()[sb.mFill] || a.palette()[sa.mColor] != b.palette()[sb.mColor] ||
+                sa.mStrokeWidth != sb.mStrokeWidth || sa.mDashLength != sb.mDashLength ||
+                sa.mGapLength != sb.mGapLength || sa.mLineStyle != sb.mLineStyle ||
+                sa.mTextAnchor != sb.mTextAnchor || sa.mFontSize != sb.mFontSize) {
+                return false;
+            }
+            const auto ca = a.coordinates(i);
+            const auto cb = b.coordinates(i);
+            if (ca.size() != cb.size()) {
+                return false;
+            }
+            for (size_t k = 0; k < ca.size(); ++k) {
+                if (ca[k].mLongitude != cb[k].mLongitude || ca[k].mLatitude != cb[k].mLatitude) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /** 每种视野跨度（度）各查询 100 × iterations 个随机视野，返回索引查询结果是否与逐个检查一致 */
+    bool runQueryBench(const FeatureStore &store, int iterations) {
+        GeoRect extent;
+        for (FeatureStore::FeatureIndex i = 0; i < store.size(); ++i) {
+            const GeoRect &bounds = store.bounds(i);
+            if (!bounds.empty()) {
+                extent.expand(bounds.mMinLongitude, bounds.mMinLatitude);
+                extent.expand(bounds.mMaxLongitude, bounds.mMaxLatitude);
+            }
+        }
+        if (extent.empty()) {
+            fmt::print("query    no feature has coordinates\n");
+            return true;
+        }
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> lon(extent.mMinLongitude, extent.mMaxLongitude);
+        std::uniform_real_distribution<double> lat(extent.mMinLatitude, extent.mMaxLatitude);
+        bool same = true;
+        std::vector<FeatureStore::FeatureIndex> scanned;
+        std::vector<FeatureStore::FeatureIndex> queried;
+        for (const double span: {0.5, 2.0, 8.0}) {
+            const int zoom = spanDegToZoomLevel(span);
+            const int count = 100 * iterations;
+            double scanMs = 0.0;
+            double tilesMs = 0.0;
+            size_t candidates = 0;
+            for (int k = 0; k < count; ++k) {
+                GeoRect view;
+                const double x = lon(rng);
+                const double y = lat(rng);
+                view.expand(x - span * 0.5, y - span * 0.5);
+                view.expand(x + span * 0.5, y + span * 0.5);
+
+                auto start = std::chrono::steady_clock::now();
+                scanned.clear();
+                for (FeatureStore::FeatureIndex i = 0; i < store.size(); ++i) {
+                    if (isZoomVisible(zoom, store.zoom(i), store.maxZoom(i)) &&
+                        geoRectsIntersect(store.bounds(i), view)) {
+                        scanned.push_back(i);
+                    }
+                }
+                auto end = std::chrono::steady_clock::now();
+                scanMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+                start = std::chrono::steady_clock::now();
+                queried.clear();
+                store.queryFeatures(view, zoom, queried);
+                end = std::chrono::steady_clock::now();
+                tilesMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+                candidates += queried.size();
+                same = same && scanned == queried;
+            }
+            fmt::print("query    span {:>4.1f} deg   zoom {:>2}   scan {:>8.3f} ms   tiles {:>8.3f} ms   candidates {:.0f}\n",
+                       span, zoom, scanMs / count, tilesMs / count, static_cast<double>(candidates) / count);
+        }
+        fmt::print("tile query {} scan\n", same ? "matches" : "DIFFERS FROM");
+        return same;
+    }
+
+    int generate(const fs::path &path, int featureCount) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) {
+            std::cerr << "cannot write " << path.string() << "\n";
+            return 1;
+        }
+        static const char *const COLOR_NAMES[] = {"red", "green", "blue", "gray", "orange"};
+        out << "color:\n"
+               "  red: \"#FF0000\"\n"
+               "  green: \"#00FF00\"\n"
+               "  blue: \"#0000FF\"\n"
+               "  gray: \"#808080\"\n"
+               "  orange: \"#FFA500\"\n"
+               "features:\n";
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> lon(73.0, 135.0);
+        std::uniform_real_distribution<double> lat(18.0, 53.0);
+        std::uniform_real_distribution<double> step(-0.05, 0.05);
+        for (int i = 0; i < featureCount; ++i) {
+            const char *color = COLOR_NAMES[i % 5];
+            double x = lon(rng);
+            double y = lat(rng);
+            switch (i % 3) {
+                case 0: {
+                    out << "  - type: line\n    color: " << color << "\n    zoom: " << (i % 12) << "\n"
+                        << "    coordinates:\n";
+                    const int points = 2 + static_cast<int>(rng() % 30);
+                    for (int k = 0; k < points; ++k, x += step(rng), y += step(rng)) {
+                        out << fmt::format("      - [{:.6f}, {:.6f}]\n", x, y);
+                    }
+                    if (i % 2 == 0) {
+                        out << "    stroke: dashed\n    dash: [8, 4]\n";
+                    }
+                    break;
+                }
+                case 1: {
+                    out << "  - type: area\n    fill: \"#33" << fmt::format("{:02X}", i % 256) << "CC\"\n"
+                        << "    color: " << color << "\n";
+                    if (i % 4 == 1) {
+                        // overview outline, hidden once zoomed in
+                        out << "    maxZoom: 7\n";
+                    }
+                    out << "    coordinates:\n";
+                    const int points = 3 + static_cast<int>(rng() % 40);
+                    for (int k = 0; k < points; ++k, x += step(rng), y += step(rng)) {
+                        out << fmt::format("      - [{:.6f}, {:.6f}]\n", x, y);
+                    }
+                    break;
+                }
+                default:
+                    out << "  - type: text\n    color: " << color << "\n    text: \"LABEL" << (i % 500) << "\"\n"
+                        << "    size: 12\n    textAnchor: center\n    zoom: 9\n"
+                        << fmt::format("    coordinates:\n      - [{:.6f}, {:.6f}]\n", x, y);
+                    break;
+            }
+        }
+        return 0;
+    }
+    std::string sectorCoordinate(double degrees, bool latitude) {
+        const char hemisphere = latitude ? (degrees < 0 ? 'S' : 'N') : (degrees < 0 ? 'W' : 'E');
+        degrees = std::abs(degrees);
+        const int whole = static_cast<int>(degrees);
+        const double minutes = (degrees - whole) * 60.0;
+        const int wholeMinutes = static_cast<int>(minutes);
+        // rounded to the printed precision, seconds must stay below 60
+        const double seconds = (std::min)((minutes - wholeMinutes) * 60.0, 59.999);
+        return fmt::format("{}{:03}.{:02}.{:06.3f}", hemisphere, whole, wholeMinutes, seconds);
+    }
+
+    /**
+     * 生成扇区文件：.sct 为 [FIXES]、首尾相接的 [GEO] 线段、[REGIONS] 和 [LABELS]，
+     * .ese 为 [AIRSPACE] 中每 50 个 COORD 一条 SECTORLINE（transform.py 的输入格式）；lineCount 为坐标行数
+     */
+    int generateSector(const fs::path &path, int lineCount) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) {
+            std::cerr << "cannot write " << path.string() << "\n";
+            return 1;
+        }
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> lon(73.0, 135.0);
+        std::uniform_real_distribution<double> lat(18.0, 53.0);
+        std::uniform_real_distribution<double> step(-0.05, 0.05);
+        auto point = [](double x, double y) {
+            return sectorCoordinate(y, true) + " " + sectorCoordinate(x, false);
+        };
+        if (path.extension() == ESE_EXTENSION) {
+            out << "[AIRSPACE]\n";
+            double x = lon(rng);
+            double y = lat(rng);
+            for (int i = 0; i < lineCount; ++i, x += step(rng), y += step(rng)) {
+                if (i % 50 == 0) {
+                    out << "SECTORLINE:" << i / 50 << "\n";
+                    x = lon(rng);
+                    y = lat(rng);
+                }
+                out << "COORD:" << sectorCoordinate(y, true) << ":" << sectorCoordinate(x, false) << "\n";
+            }
+            return 0;
+        }
+        out << "#define coast 9076039\n#define border 255\n#define land 3355443\n\n[FIXES]\n";
+        for (int i = 0; i < 100; ++i) {
+            out << fmt::format("FIX{:02} {}\n", i, point(lon(rng), lat(rng)));
+        }
+        out << "\n[GEO]\n";
+        double x = lon(rng);
+        double y = lat(rng);
+        for (int i = 0; i < lineCount * 3 / 5; ++i) {
+            if (i % 40 == 0) {
+                x = lon(rng);
+                y = lat(rng);
+            }
+            const double nextX = x + step(rng);
+            const double nextY = y + step(rng);
+            out << fmt::format("COAST{} {} {} {}\n", i / 40, point(x, y), point(nextX, nextY),
+                               i % 80 < 40 ? "coast" : "border");
+            x = nextX;
+            y = nextY;
+        }
+        out << "\n[REGIONS]\n";
+        for (int i = 0; i < lineCount * 3 / 10; ++i, x += step(rng), y += step(rng)) {
+            if (i % 30 == 0) {
+                x = lon(rng);
+                y = lat(rng);
+                out << fmt::format("REGIONNAME AREA{}\nland {}\n", i / 30, point(x, y));
+            } else {
+                out << "     " << point(x, y) << "\n";
+            }
+        }
+        out << "\n[LABELS]\n";
+        for (int i = 0; i < lineCount / 10; ++i) {
+            out << fmt::format("\"LABEL{}\" {} border\n", i % 500, point(lon(rng), lat(rng)));
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && std::string(argv[1]) == "--generate") {
+        return generate(argv[2], std::atoi(argv[3]));
+    }
+    if (argc >= 4 && std::string(argv[1]) == "--generate-sector") {
+        return generateSector(argv[2], std::atoi(argv[3]));
+    }
+    if (argc < 2) {
+        std::cerr << "usage: erp-bench <data.yaml> [iterations] "
+                     "[--mode stream|parallel|dom|cache|reload|geojson|query|all] "
+                     "[--threads N]\n"
+                     "       erp-bench --generate <out.yaml> <featureCount>\n"
+                     "       erp-bench --generate-sector <out.sct|out.ese> <lineCount>\n";
+        return 2;
+    }
+
+    const fs::path path = argv[1];
+    int iterations = 3;
+    size_t threads = 0;
+    std::string mode = "all";
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--mode" && i + 1 < argc) {
+            mode = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<size_t>((std::max)(0, std::atoi(argv[++i])));
+        } else {
+            iterations = (std::max)(1, std::atoi(arg.c_str()));
+        }
+    }
+
+    try {
+        fmt::print("{}: {} bytes, {} iteration(s)\n", path.string(), fs::file_size(path), iterations);
+        if (isSectorFilePath(path)) {
+            printResult("sector", runSectorBench(path, iterations));
+            return 0;
+        }
+        std::vector<BenchResult> results;
+        for (YamlLoadMode loadMode: {YamlLoadMode::Stream, YamlLoadMode::Parallel, YamlLoadMode::Dom}) {
+            const std::string name = yamlLoadModeToString(loadMode);
+            if (mode != "all" && mode != name) {
+                continue;
+            }
+            results.push_back(runBench(path, loadMode, iterations, threads, false));
+            printResult(name, results.back());
+        }
+        if (mode == "all" || mode == "cache") {
+            const fs::path cachePath = RenderDataProvider::binaryCachePath(path);
+            fs::remove(cachePath);
+            results.push_back(runBench(path, YamlLoadMode::Parallel, (std::max)(iterations, 2), threads, true));
+            printResult("cache", results.back());
+            fmt::print("first load (parse + write) {:.2f} ms, cache file {} bytes\n",
+                       results.back().mMilliseconds.front(), fs::file_size(cachePath));
+            fs::remove(cachePath);
+        }
+        if (mode == "all" || mode == "geojson") {
+            const fs::path exported = fs::temp_directory_path() / "erp-bench-export.geojson";
+            const auto source = results.empty() ? runBench(path, YamlLoadMode::Parallel, 1, threads, false)
+                                                : results.front();
+            writeGeoJson(*source.mStore, exported);
+            if (results.empty()) {
+                results.push_back(source);
+                printResult("parallel", source);
+            }
+            results.push_back(runGeoJsonBench(exported, iterations));
+            printResult("geojson", results.back());
+            fmt::print("geojson file {} bytes\n", fs::file_size(exported));
+            fs::remove(exported);
+        }
+        if (mode == "all" || mode == "query") {
+            const auto source = results.empty() ? runBench(path, YamlLoadMode::Parallel, 1, threads, false)
+                                                : results.front();
+            if (!runQueryBench(*source.mStore, iterations)) {
+                return 1;
+            }
+            if (mode == "query") {
+                return 0;
+            }
+        }
+        if (mode == "all" || mode == "reload") {
+            const fs::path edited = fs::temp_directory_path() / "erp-bench-edited.yaml";
+            writeEditedCopy(path, edited);
+            auto full = runBench(edited, YamlLoadMode::Parallel, 1, threads, false);
+            printResult("full", full);
+            results.push_back(runReloadBench(path, edited, iterations, threads));
+            printResult("reload", results.back());
+            const bool sameAsFull = sameStore(*full.mStore, *results.back().mStore);
+            fmt::print("incremental reload {} full load of the edited file\n", sameAsFull ? "matches" : "DIFFERS FROM");
+            fs::remove(edited);
+            if (!sameAsFull) {
+                return 1;
+            }
+            if (mode == "reload") {
+                return 0;
+            }
+            // the edited file only differs in a comment, so it is comparable with the other modes
+        }
+        bool same = true;
+        for (size_t i = 1; i < results.size(); ++i) {
+            same = same && sameStore(*results.front().mStore, *results[i].mStore);
+        }
+        if (results.size() > 1) {
+            fmt::print("results {}\n", same ? "identical" : "DIFFER");
+        }
+        return same ? 0 : 1;
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2026 Half_nothing
+// SPDX-License-Identifier: MIT
+
+// 离线数据集编译器：按插件相同的解码规则读取 config.yaml 格式、GeoJSON（.geojson / .json）
+// 或 EuroScope 扇区文件（.sct / .sct2 / .ese）的数据文件，输出编译后的 .erpbin 数据集并打印诊断
+//
+//   erp-compile <data.yaml|data.geojson|data.sct> [-o <out.erpbin>] [--storage double|quantized] [--strict] [--quiet]
+//
+// 默认输出到数据文件旁的同名 .erpbin，与数据文件一起发布时插件校验源文件哈希后直接映射，不再解析 YAML；
+// 数据文件 include 了其他文件时，每个文件旁各生成一个 .erpbin。
+// 也可以只发布 -o 指定的 .erpbin（合并了 include 的全部文件），并将 ConfigPath 指向它。
+// 坐标存储方式须与插件的 CoordinateStorage 设置一致。
+// 退出码：0 成功，1 读取或写入失败，2 参数错误，3 使用 --strict 且存在加载错误或诊断（此时不写出文件）
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "dataset_diagnostics.h"
+#include "feature_store_binary.h"
+#include "hash_utils.h"
+#include "mapped_file.h"
+#include "render_data_geojson_provider.h"
+#include "render_data_sector_provider.h"
+#include "render_data_yaml_provider.h"
+#include "string_utils.h"
+
+namespace {
+    using namespace RenderPlugin;
+
+    int usage() {
+        std::cerr << "usage: erp-compile <data.yaml|data.geojson|data.sct> [-o <out.erpbin>] "
+                     "[--storage double|quantized] [--strict] [--quiet]\n";
+        return 2;
+    }
+
+    std::unique_ptr<RenderDataProvider> createProvider(const fs::path &input, CoordinateStorage storage) {
+        std::unique_ptr<RenderDataProvider> provider;
+        if (isGeoJsonPath(input)) {
+            provider = std::make_unique<RenderDataGeoJsonProvider>();
+        } else if (isSectorFilePath(input)) {
+            provider = std::make_unique<RenderDataSectorProvider>();
+        } else {
+            provider = std::make_unique<RenderDataYamlProvider>();
+        }
+        provider->setCoordinateStorage(storage);
+        return provider;
+    }
+
+    std::string describeFeature(const FeatureStore &store, FeatureStore::FeatureIndex index) {
+        std::string description = fmt::format("feature #{} ({}", index, renderTypeToString(store.type(index)));
+        const auto text = store.text(index);
+        if (!text.empty()) {
+            description += fmt::format(" \"{}\"", WstringToUtf8(std::wstring(text)));
+        }
+        const auto coordinates = store.coordinates(index);
+        if (!coordinates.empty()) {
+            description += fmt::format(" at {:.6f}, {:.6f}", coordinates[0].mLongitude, coordinates[0].mLatitude);
+        }
+        return description + ")";
+    }
+}
+
+int main(int argc, char **argv) {
+    fs::path input;
+    fs::path output;
+    CoordinateStorage storage = CoordinateStorage::Double;
+    bool strict = false;
+    bool quiet = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--storage" && i + 1 < argc) {
+            storage = stringToCoordinateStorage(argv[++i]);
+        } else if (arg == "--strict") {
+            strict = true;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (!arg.empty() && arg[0] != '-' && input.empty()) {
+            input = arg;
+        } else {
+            return usage();
+        }
+    }
+    if (input.empty()) {
+        return usage();
+    }
+
+    try {
+        auto source = MappedFile::open(input);
+        if (!source) {
+            std::cerr << input.string() << ": cannot open file\n";
+            return 1;
+        }
+        const uint64_t sourceHash = hashBytes(source->view());
+
+        // without -o every source file gets its own cache, written while loading; with --strict only after the check
+        const bool writeCaches = output.empty();
+        auto provider = createProvider(input, storage);
+        provider->setBinaryCacheRebuild(writeCaches && !strict);
+        if (!provider->loadData(input)) {
+            std::cerr << input.string() << ": missing 'color' or 'features' section\n";
+            return 1;
+        }
+        auto store = provider->getFeatureStore();
+
+        // fields and features with data errors were left out of the store, they are reported like diagnostics
+        const auto &loadErrors = provider->getLoadErrors();
+        if (!quiet) {
+            for (const auto &error: loadErrors) {
+                fmt::print("{}:{}: error: {}\n", error.mFile.empty() ? input.string() : error.mFile, error.mLine,
+                           error.mMessage);
+            }
+        }
+        if (!loadErrors.empty()) {
+            fmt::print("{}: {} load error(s)\n", input.string(), loadErrors.size());
+        }
+
+        const auto diagnostics = diagnoseDataset(*store, *provider->getColorMap());
+        std::map<DiagnosticKind, size_t> counts;
+        for (const auto &diagnostic: diagnostics) {
+            ++counts[diagnostic.mKind];
+            if (!quiet) {
+                fmt::print("{}: {}: {}: {}\n", input.string(), describeFeature(*store, diagnostic.mFeature),
+                           diagnosticKindToString(diagnostic.mKind), diagnostic.mMessage);
+            }
+        }
+        for (const auto &[kind, count]: counts) {
+            fmt::print("{}: {} {} diagnostic(s)\n", input.string(), count, diagnosticKindToString(kind));
+        }
+        if (strict && (!diagnostics.empty() || !loadErrors.empty())) {
+            std::cerr << input.string() << ": not written, " << loadErrors.size() << " load error(s) and "
+                      << diagnostics.size() << " diagnostic(s) with --strict\n";
+            return 3;
+        }
+
+        fmt::print("{}: {} features, {} coordinates, {} styles, {} colors, {} storage\n",
+                   input.string(), store->size(), store->coordinateCount(), store->styleCount(),
+                   store->palette().size(), coordinateStorageToString(storage));
+        if (!writeCaches) {
+            std::error_code error;
+            if (!FeatureStoreBinary::write(*store, sourceHash, output, error)) {
+                std::cerr << output.string() << ": cannot write file: " << error.message() << "\n";
+                return 1;
+            }
+            fmt::print("{} -> {} ({} bytes)\n", input.string(), output.string(), fs::file_size(output));
+            return 0;
+        }
+        if (strict) {
+            provider = createProvider(input, storage);
+            provider->setBinaryCacheRebuild(true);
+            if (!provider->loadData(input)) {
+                std::cerr << input.string() << ": missing 'color' or 'features' section\n";
+                return 1;
+            }
+        }
+        for (const auto &notice: provider->getLoadNotices()) {
+            std::cerr << notice << "\n";
+        }
+        int result = 0;
+        for (const auto &file: provider->getSourceFiles()) {
+            const fs::path cachePath = RenderDataProvider::binaryCachePath(file.mPath);
+            // a failed write leaves an older cache behind, which no longer matches the source
+            if (!FeatureStoreBinary::load(cachePath, file.mContentHash, storage)) {
+                std::cerr << cachePath.string() << ": cannot write file\n";
+                result = 1;
+                continue;
+            }
+            fmt::print("{} -> {} ({} bytes)\n", file.mPath.string(), cachePath.string(), fs::file_size(cachePath));
+        }
+        return result;
+    } catch (const std::exception &e) {
+        std::cerr << input.string() << ": " << e.what() << "\n";
+        return 1;
+    }
+}